@@ -10,6 +10,9 @@
 #include "CharacterController.hpp"
 #include "EnemyParameters.hpp"
 #include "Physics/World.hpp"
+#include "Physics/StepDriver.hpp"
+#include "PhysicsThread.hpp"
+#include "LevelStreamer.hpp"
 
 #if defined(PLATFORM_WEB)
 void UpdateLoop(void* arg);
@@ -26,7 +29,7 @@ class Application {
 	friend void UpdateLoop(void* arg);
 #endif
 public:
-	Application(int width = 800, int height = 450, const std::string& name = "Application", bool isEditing = false);
+	Application(int width = 800, int height = 450, const std::string& name = "Application", bool isEditing = false, bool usePhysicsThread = false);
 	~Application();
 	Application(const Application &) = delete;
 	Application &operator=(const Application &) = delete;
@@ -37,6 +40,9 @@ public:
 	static inline const std::filesystem::path c_DeadlyPlatformsFilePath = "deadly_platforms.fyc";
 	static inline const std::filesystem::path c_EnemiesFilePath = "enemies.fyc";
 	static inline const std::filesystem::path c_EndPlatformFilePath = "end_platform.fyc";
+	/// Chunked level streamed into the play world around the character, on top of the world.
+	static inline const std::filesystem::path c_StreamedWorldFilePath = "streamed.fyc";
+	static inline const FYC::Real c_StreamedTileSize = 16;
 public:
 	void Run();
 private:
@@ -48,10 +54,13 @@ private:
 
 	void UpdateLogic();
 	void UpdateRendering();
+	static void DrawShape(const FYC::Particle::Shape& shape, FYC::Vec2 position, Color color);
 
 	void ClearWorld();
 	void LoadWorld(const std::filesystem::path &filepath);
 	void SaveWorld(const std::filesystem::path &filename) const;
+	void SaveStreamedWorld(const std::filesystem::path &filename) const;
+	void UpdateLevelStreaming();
 
 	void ClearCharacter();
 	void LoadCharacter(const std::filesystem::path &filepath);
@@ -80,6 +89,9 @@ private:
 	void TryRestart();
 	void Stop();
 	void Play();
+	/// Put the play world back as Play left it, cheaper than copying the edit world again.
+	void Restart();
+	void StartPhysicsThread();
 
 	void RenderImGui();
 	bool RenderImGuiCamera();
@@ -87,10 +99,15 @@ private:
 	bool RenderImGuiCharacter();
 	bool RenderImGuiDeadlyPlatforms();
 	bool RenderImGuiEnemies();
+	void RenderImGuiStepStatistics(const FYC::StepStatistics& statistics);
+	void RenderImGuiMemoryStats(const FYC::MemoryStats& memory, const FYC::MemoryStats& peakMemory, uint64_t peakTotalMemory);
 
-	void OnCollision(FYC::World::WorldIterator particle, FYC::World::WorldIterator other, FYC::Collision collision);
+	void OnContacts(std::span<const FYC::World::ContactEvent> events);
+	void OnSensors(std::span<const FYC::World::SensorEvent> events);
 
 	struct ImGuiParticleResult {bool hasChanged{false}; bool shouldLive{true};};
+	/// Input read on the main thread and consumed by the steps, which may run on the physics thread.
+	struct CharacterInput {FYC::Vec2 Movement{0}; bool Jump{false};};
 	ImGuiParticleResult RenderImGuiParticle(FYC::World::WorldIterator it, bool canBeDeleted = true);
 
 	void Pause(bool isPause);
@@ -106,9 +123,17 @@ private:
 	std::vector<FYC::World::ID> m_EnemyIds;
 	std::vector<FYC::World::ID> m_DeadlyPlatform;
 	FYC::World::ID m_EndPlatform = FYC::World::NULL_ID;
-	bool m_ShouldStop = false;
-	bool m_ShouldPlay = false;
-	bool m_HasWon = false;
+	/// Wall-clock budget of a physics step in milliseconds, 0 to let the step take as long as it needs.
+	float m_StepBudgetMilliseconds = 0.0f;
+	/// The jump key is read every frame but consumed by the next physics step, which may not run on the same frame.
+	CharacterInput m_CharacterInput;
+	// Set by the collision callbacks, which run on the physics thread when it is used.
+	std::atomic<bool> m_ShouldStop = false;
+	std::atomic<bool> m_ShouldPlay = false;
+	std::atomic<bool> m_ShouldRestart = false;
+	std::atomic<bool> m_HasWon = false;
+	/// Step the play world on its own thread, the main thread then only draws its snapshots.
+	bool m_UsePhysicsThread = false;
 private:
 	bool m_ImGuiIsActive = false;
 	PhysicsMode m_PhysicsMode = PhysicsMode::Edit;
@@ -119,4 +144,10 @@ private:
 	FYC::Application::Camera m_Camera;
 	FYC::World m_WorldEdit;
 	FYC::World m_WorldPlay;
+	/// The play world as Play set it up, restored by the restarts.
+	FYC::World::Snapshot m_PlaySnapshot;
+	FYC::StepDriver m_StepDriver;
+	FYC::Application::LevelStreamer m_LevelStreamer;
+	// Declared last so it stops before the world and the driver it steps are destroyed.
+	FYC::Application::PhysicsThread m_PhysicsThread;
 };
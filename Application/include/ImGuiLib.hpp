@@ -9,49 +9,96 @@
 
 namespace ImGuiLib
 {
-#ifdef FYC_DOUBLE
+#if defined(FYC_FIXED)
+	// ImGui has no fixed-point data type, the values are edited through a float copy.
+	inline static constexpr ImGuiDataType_ ImGuiRealDataType = ImGuiDataType_Float;
+	using ImGuiReal = float;
+#elif defined(FYC_DOUBLE)
 	inline static constexpr ImGuiDataType_ ImGuiRealDataType = ImGuiDataType_Double;
+	using ImGuiReal = double;
 #else
 	inline static constexpr ImGuiDataType_ ImGuiRealDataType = ImGuiDataType_Float;
+	using ImGuiReal = float;
 #endif
 
+	template<int N>
+	struct RealProxy
+	{
+		explicit RealProxy(FYC::Real* values) : Target(values) { for (int i = 0; i < N; ++i) Values[i] = static_cast<ImGuiReal>(values[i]); }
+		bool Commit(const bool changed) { if (changed) for (int i = 0; i < N; ++i) Target[i] = Values[i]; return changed; }
+
+		FYC::Real* Target;
+		ImGuiReal Values[N];
+	};
+
 	inline static bool DragReal(const char* label, FYC::Real* v, float v_speed = 1.0f, FYC::Real v_min = 0.0f, FYC::Real v_max = 0.0f, const char* format = "%.3f", ImGuiSliderFlags flags = 0) {
-		return ImGui::DragScalar(label, ImGuiRealDataType, v, v_speed, &v_min, &v_max, format, flags);
+		RealProxy<1> proxy{v}; ImGuiReal min{static_cast<ImGuiReal>(v_min)}, max{static_cast<ImGuiReal>(v_max)};
+		return proxy.Commit(ImGui::DragScalar(label, ImGuiRealDataType, proxy.Values, v_speed, &min, &max, format, flags));
     }
 	inline static bool DragReal2(const char* label, FYC::Real v[2], float v_speed = 1.0f, FYC::Real v_min = 0.0f, FYC::Real v_max = 0.0f, const char* format = "%.3f", ImGuiSliderFlags flags = 0) {
-		return ImGui::DragScalarN(label, ImGuiRealDataType, v, 2, v_speed, &v_min, &v_max, format, flags);
+		RealProxy<2> proxy{v}; ImGuiReal min{static_cast<ImGuiReal>(v_min)}, max{static_cast<ImGuiReal>(v_max)};
+		return proxy.Commit(ImGui::DragScalarN(label, ImGuiRealDataType, proxy.Values, 2, v_speed, &min, &max, format, flags));
 	}
 	inline static bool DragReal3(const char* label, FYC::Real v[3], float v_speed = 1.0f, FYC::Real v_min = 0.0f, FYC::Real v_max = 0.0f, const char* format = "%.3f", ImGuiSliderFlags flags = 0) {
-		return ImGui::DragScalarN(label, ImGuiRealDataType, v, 3, v_speed, &v_min, &v_max, format, flags);
+		RealProxy<3> proxy{v}; ImGuiReal min{static_cast<ImGuiReal>(v_min)}, max{static_cast<ImGuiReal>(v_max)};
+		return proxy.Commit(ImGui::DragScalarN(label, ImGuiRealDataType, proxy.Values, 3, v_speed, &min, &max, format, flags));
 	}
 	inline static bool DragReal4(const char* label, FYC::Real v[4], float v_speed = 1.0f, FYC::Real v_min = 0.0f, FYC::Real v_max = 0.0f, const char* format = "%.3f", ImGuiSliderFlags flags = 0) {
-		return ImGui::DragScalarN(label, ImGuiRealDataType, v, 4, v_speed, &v_min, &v_max, format, flags);
+		RealProxy<4> proxy{v}; ImGuiReal min{static_cast<ImGuiReal>(v_min)}, max{static_cast<ImGuiReal>(v_max)};
+		return proxy.Commit(ImGui::DragScalarN(label, ImGuiRealDataType, proxy.Values, 4, v_speed, &min, &max, format, flags));
 	}
 
 	inline static bool SliderReal(const char* label, FYC::Real* v, FYC::Real v_min = 0.0f, FYC::Real v_max = 0.0f, const char* format = "%.3f", ImGuiSliderFlags flags = 0) {
-    	return ImGui::SliderScalar(label, ImGuiRealDataType, v, &v_min, &v_max, format, flags);
+		RealProxy<1> proxy{v}; ImGuiReal min{static_cast<ImGuiReal>(v_min)}, max{static_cast<ImGuiReal>(v_max)};
+    	return proxy.Commit(ImGui::SliderScalar(label, ImGuiRealDataType, proxy.Values, &min, &max, format, flags));
 	}
 	inline static bool SliderReal2(const char* label, FYC::Real v[2], FYC::Real v_min = 0.0f, FYC::Real v_max = 0.0f, const char* format = "%.3f", ImGuiSliderFlags flags = 0) {
-    	return ImGui::SliderScalarN(label, ImGuiRealDataType, v, 2, &v_min, &v_max, format, flags);
+		RealProxy<2> proxy{v}; ImGuiReal min{static_cast<ImGuiReal>(v_min)}, max{static_cast<ImGuiReal>(v_max)};
+    	return proxy.Commit(ImGui::SliderScalarN(label, ImGuiRealDataType, proxy.Values, 2, &min, &max, format, flags));
 	}
 	inline static bool SliderReal3(const char* label, FYC::Real v[3], FYC::Real v_min = 0.0f, FYC::Real v_max = 0.0f, const char* format = "%.3f", ImGuiSliderFlags flags = 0) {
-    	return ImGui::SliderScalarN(label, ImGuiRealDataType, v, 3, &v_min, &v_max, format, flags);
+		RealProxy<3> proxy{v}; ImGuiReal min{static_cast<ImGuiReal>(v_min)}, max{static_cast<ImGuiReal>(v_max)};
+    	return proxy.Commit(ImGui::SliderScalarN(label, ImGuiRealDataType, proxy.Values, 3, &min, &max, format, flags));
 	}
 	inline static bool SliderReal4(const char* label, FYC::Real v[4], FYC::Real v_min = 0.0f, FYC::Real v_max = 0.0f, const char* format = "%.3f", ImGuiSliderFlags flags = 0) {
-		return ImGui::SliderScalarN(label, ImGuiRealDataType, v, 4, &v_min, &v_max, format, flags);
+		RealProxy<4> proxy{v}; ImGuiReal min{static_cast<ImGuiReal>(v_min)}, max{static_cast<ImGuiReal>(v_max)};
+		return proxy.Commit(ImGui::SliderScalarN(label, ImGuiRealDataType, proxy.Values, 4, &min, &max, format, flags));
 	}
 
 	inline static bool InputReal(const char* label, FYC::Real* v, FYC::Real step = 0.0f, FYC::Real step_fast = 0.0f, const char* format = "%.3f", ImGuiInputTextFlags flags = 0) {
-    	return ImGui::InputScalar(label, ImGuiRealDataType, (void*)v, (void*)(step > 0.0f ? &step : NULL), (void*)(step_fast > 0.0f ? &step_fast : NULL), format, flags);
+		RealProxy<1> proxy{v}; ImGuiReal imStep{static_cast<ImGuiReal>(step)}, imStepFast{static_cast<ImGuiReal>(step_fast)};
+    	return proxy.Commit(ImGui::InputScalar(label, ImGuiRealDataType, (void*)proxy.Values, (void*)(step > 0.0f ? &imStep : NULL), (void*)(step_fast > 0.0f ? &imStepFast : NULL), format, flags));
 	}
 	inline static bool InputReal2(const char* label, FYC::Real v[2], const char* format = "%.3f", ImGuiInputTextFlags flags = 0) {
-    	return ImGui::InputScalarN(label, ImGuiRealDataType, v, 2, NULL, NULL, format, flags);
+		RealProxy<2> proxy{v};
+    	return proxy.Commit(ImGui::InputScalarN(label, ImGuiRealDataType, proxy.Values, 2, NULL, NULL, format, flags));
 	}
 	inline static bool InputReal3(const char* label, FYC::Real v[3], const char* format = "%.3f", ImGuiInputTextFlags flags = 0) {
-    	return ImGui::InputScalarN(label, ImGuiRealDataType, v, 3, NULL, NULL, format, flags);
+		RealProxy<3> proxy{v};
+    	return proxy.Commit(ImGui::InputScalarN(label, ImGuiRealDataType, proxy.Values, 3, NULL, NULL, format, flags));
 	}
 	inline static bool InputReal4(const char* label, FYC::Real v[4], const char* format = "%.3f", ImGuiInputTextFlags flags = 0) {
-		return ImGui::InputScalarN(label, ImGuiRealDataType, v, 4, NULL, NULL, format, flags);
+		RealProxy<4> proxy{v};
+		return proxy.Commit(ImGui::InputScalarN(label, ImGuiRealDataType, proxy.Values, 4, NULL, NULL, format, flags));
+	}
+
+	inline static bool DragReal2(const char* label, FYC::Vec2& v, float v_speed = 1.0f, FYC::Real v_min = 0.0f, FYC::Real v_max = 0.0f, const char* format = "%.3f", ImGuiSliderFlags flags = 0) {
+		FYC::Real values[2] {v.x, v.y};
+		if (!DragReal2(label, values, v_speed, v_min, v_max, format, flags)) return false;
+		v = {values[0], values[1]};
+		return true;
+	}
+	inline static bool SliderReal2(const char* label, FYC::Vec2& v, FYC::Real v_min = 0.0f, FYC::Real v_max = 0.0f, const char* format = "%.3f", ImGuiSliderFlags flags = 0) {
+		FYC::Real values[2] {v.x, v.y};
+		if (!SliderReal2(label, values, v_min, v_max, format, flags)) return false;
+		v = {values[0], values[1]};
+		return true;
+	}
+	inline static bool InputReal2(const char* label, FYC::Vec2& v, const char* format = "%.3f", ImGuiInputTextFlags flags = 0) {
+		FYC::Real values[2] {v.x, v.y};
+		if (!InputReal2(label, values, format, flags)) return false;
+		v = {values[0], values[1]};
+		return true;
 	}
 
 } // ImGuiLib
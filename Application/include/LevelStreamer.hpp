@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Physics/Math.hpp"
+#include "Physics/World.hpp"
+#include "MappedFile.hpp"
+#include "WorldSerializer.hpp"
+
+namespace FYC::Application {
+
+	struct LevelStreamerSettings {
+		/// Tiles whose particles come closer than this to the focus are loaded.
+		Real LoadDistance{24};
+		/// Tiles whose particles all go further than this are removed. Larger than LoadDistance so a tile on the edge doesn't reload every frame.
+		Real UnloadDistance{32};
+		/// Particles added to the world by an update, 0 to add every decoded tile at once.
+		uint32_t ParticlesPerUpdate = 4096;
+	};
+
+	/**
+	 * Streams the tiles of a chunked level in and out of a world around a focus point.
+	 * The tiles are decoded from the mapped file on a background thread, added to the world in batches by Update,
+	 * and removed once far from the focus, so the world only holds the part of the level around it.
+	 * The particles of a tile get new IDs every time it is added, and the ones removed by the game come back with it.
+	 */
+	class LevelStreamer
+	{
+	public:
+		LevelStreamer();
+		~LevelStreamer();
+		LevelStreamer(const LevelStreamer&) = delete;
+		LevelStreamer& operator=(const LevelStreamer&) = delete;
+	public:
+		/**
+		 * Map the chunked level and start its decoding thread, closing the level open before.
+		 * The file stays mapped until Close and must not be written meanwhile.
+		 */
+		bool Open(const std::filesystem::path& filepath);
+		/// Stop the decoding thread and unmap the level, the particles added stay in the world.
+		void Close();
+		[[nodiscard]] bool IsOpen() const;
+
+		/// Forget the tiles added, for when the world was restored or replaced and doesn't hold them anymore.
+		void Reset();
+
+		/**
+		 * Add the decoded tiles near the focus, remove the far ones, and queue the decoding of the tiles coming near.
+		 * Must be called by the thread owning the world, between steps.
+		 */
+		void Update(World& world, const Vec2& focus);
+
+		[[nodiscard]] uint64_t GetTileCount() const;
+		[[nodiscard]] uint64_t GetLoadedTileCount() const;
+		/// Particles of the level currently in the world.
+		[[nodiscard]] uint64_t GetLoadedParticleCount() const;
+	public:
+		LevelStreamerSettings Settings;
+	private:
+		enum class TileState : uint8_t { Unloaded, Queued, Inserting, Loaded };
+		struct Tile {
+			LevelTile Level;
+			TileState State = TileState::Unloaded;
+			/// Particles of the tile in the world.
+			std::vector<World::ID> Ids;
+		};
+		struct DecodedTile {
+			uint32_t Index;
+			std::vector<Particle> Particles;
+		};
+	private:
+		void Loop();
+		void RemoveTile(World& world, Tile& tile);
+		[[nodiscard]] int32_t GetTileCoordinate(Real position) const;
+		[[nodiscard]] static uint64_t GetTileKey(int32_t x, int32_t y);
+		[[nodiscard]] static Real GetDistance(const AABB& bounds, const Vec2& point);
+	private:
+		MappedFile m_File;
+		LevelView m_Level;
+		std::vector<Tile> m_Tiles;
+		/// Index of the tiles by their coordinates, so an update only looks at the tiles around the focus.
+		std::unordered_map<uint64_t, uint32_t> m_TileIndices;
+		/// How far the particles of a tile stick out of its square at most.
+		Real m_TileOverhang{0};
+		/// Tiles that aren't unloaded.
+		std::vector<uint32_t> m_ActiveTiles;
+		/// Decoded tiles being added to the world, the first one partly.
+		std::deque<DecodedTile> m_Inserting;
+		// Written by the thread calling Update, read by the interface while the physics thread runs.
+		std::atomic<uint64_t> m_LoadedTileCount = 0;
+		std::atomic<uint64_t> m_LoadedParticleCount = 0;
+
+		std::thread m_Thread;
+		std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		// Shared with the decoding thread, guarded by the mutex.
+		bool m_Stopping = false;
+		std::deque<uint32_t> m_Requests;
+		std::vector<DecodedTile> m_Decoded;
+	};
+
+} // FYC::Application
@@ -0,0 +1,34 @@
+#pragma once
+
+namespace FYC::Application {
+
+	/**
+	 * Read-only view of a whole file mapped in memory, the pages are read from the disk when first touched.
+	 * Falls back to reading the file into memory when it can't be mapped, like an empty file.
+	 */
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		explicit MappedFile(const std::filesystem::path& filepath);
+		~MappedFile();
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+	public:
+		/// Content of the file, valid as long as the MappedFile is alive.
+		[[nodiscard]] std::span<const char> GetData() const;
+		[[nodiscard]] bool IsOpen() const { return m_IsOpen; }
+		[[nodiscard]] bool IsMapped() const { return m_Mapping != nullptr; }
+		[[nodiscard]] explicit operator bool() const { return m_IsOpen; }
+	private:
+		void Close();
+	private:
+		const char* m_Mapping = nullptr;
+		uint64_t m_Size = 0;
+		std::vector<char> m_Buffer;
+		bool m_IsOpen = false;
+	};
+
+} // FYC::Application
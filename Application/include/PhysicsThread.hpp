@@ -0,0 +1,87 @@
+#pragma once
+
+#include <raylib.h>
+#include "Physics/Math.hpp"
+#include "Physics/World.hpp"
+#include "Physics/StepDriver.hpp"
+#include "TripleBuffer.hpp"
+
+namespace FYC::Application {
+
+	/// What the rendering needs from a particle.
+	struct RenderParticle {
+		Vec2 PreviousPosition;
+		Vec2 Position;
+		Particle::Shape Shape;
+		Color Tint;
+	};
+
+	/// Copy of the world published after the steps of an update, never modified once published.
+	struct RenderSnapshot {
+		std::vector<RenderParticle> Particles;
+		std::variant<std::monostate, AABB> Bounds;
+		StepStatistics Statistics;
+		MemoryStats Memory;
+		MemoryStats PeakMemory;
+		uint64_t PeakTotalMemory = 0;
+		World::Clock::time_point StepTime;
+		Real FixedStepTime{0};
+
+		/// How far the wall clock is into the step following the snapshot, from 0 to 1.
+		[[nodiscard]] Real GetAlpha(World::Clock::time_point now) const;
+	};
+
+	/**
+	 * Steps a world with a StepDriver on a dedicated thread.
+	 * While it runs the thread owns the world, the driver and whatever the step callbacks touch:
+	 * the main thread reaches them through posted commands and only reads the published snapshots.
+	 */
+	class PhysicsThread
+	{
+	public:
+		using Command = std::function<void(World& world)>;
+	public:
+		PhysicsThread();
+		~PhysicsThread();
+		PhysicsThread(const PhysicsThread&) = delete;
+		PhysicsThread& operator=(const PhysicsThread&) = delete;
+	public:
+		/**
+		 * Start stepping the world, the callbacks are the ones of StepDriver::Update and run on the physics thread.
+		 * The world and the driver must outlive the thread, or Stop must be called first.
+		 */
+		void Start(World& world, StepDriver& driver, StepDriver::StepCallback beforeStep, StepDriver::StepCallback afterStep);
+
+		/// Wait for the running update to end and join the thread, the world belongs to the caller again.
+		void Stop();
+
+		[[nodiscard]] bool IsRunning() const;
+
+		/// Queue a command run on the physics thread before its next update, in the order they were posted.
+		void Post(Command command);
+
+		/// Latest published snapshot, it stays valid until the next call. Main thread only.
+		[[nodiscard]] const RenderSnapshot& GetSnapshot();
+
+		/// Fill the snapshot with the particles holding a color, between the two last steps of the driver.
+		static void Capture(World& world, const StepDriver& driver, RenderSnapshot& snapshot);
+	private:
+		void Loop();
+		void RunCommands();
+	private:
+		std::thread m_Thread;
+		std::atomic<bool> m_Stopping{false};
+
+		std::mutex m_CommandsMutex;
+		std::vector<Command> m_Commands;
+		std::vector<Command> m_RunningCommands;
+
+		TripleBuffer<RenderSnapshot> m_Snapshots;
+
+		World* m_World = nullptr;
+		StepDriver* m_Driver = nullptr;
+		StepDriver::StepCallback m_BeforeStep;
+		StepDriver::StepCallback m_AfterStep;
+	};
+
+} // FYC::Application
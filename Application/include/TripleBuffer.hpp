@@ -0,0 +1,46 @@
+#pragma once
+
+namespace FYC::Application {
+
+	/**
+	 * Lock-free single producer, single consumer triple buffer.
+	 * The producer fills its buffer and publishes it, the consumer picks up the latest published buffer.
+	 * Neither side ever waits for the other, buffers published faster than they are read are skipped.
+	 */
+	template<typename T>
+	class TripleBuffer
+	{
+	public:
+		/// Buffer the producer may write, until it publishes it.
+		[[nodiscard]] T& GetWriteBuffer() { return m_Buffers[m_Write]; }
+
+		/// Hand the write buffer over to the consumer, and take back the buffer it isn't reading.
+		void Publish()
+		{
+			m_Write = m_Middle.exchange(m_Write | FreshFlag, std::memory_order_acq_rel) & IndexMask;
+		}
+
+		/**
+		 * Switch the read buffer to the latest published one, if any was published since the last call.
+		 * @return Whether the read buffer changed
+		 */
+		bool Update()
+		{
+			if ((m_Middle.load(std::memory_order_relaxed) & FreshFlag) == 0) return false;
+			m_Read = m_Middle.exchange(m_Read, std::memory_order_acq_rel) & IndexMask;
+			return true;
+		}
+
+		/// Buffer the consumer reads, it stays untouched until the next Update.
+		[[nodiscard]] const T& GetReadBuffer() const { return m_Buffers[m_Read]; }
+	private:
+		static constexpr uint8_t IndexMask = 0b011;
+		static constexpr uint8_t FreshFlag = 0b100;
+	private:
+		std::array<T, 3> m_Buffers{};
+		std::atomic<uint8_t> m_Middle{1};
+		uint8_t m_Write = 0;
+		uint8_t m_Read = 2;
+	};
+
+} // FYC::Application
@@ -13,34 +13,170 @@
 
 namespace FYC::Application {
 
-	struct SerializedParticle {
-		enum Shape : uint8_t {CIRCLE, RECTANGLE};
-		World::ID id;
-		Vec2 position;
-		Vec2 velocity;
-		Vec2 constantAccelerations;
-		Real rebound;
-		Real drag;
-		bool isKinematic;
-		bool isAwake;
-		Shape shapeType;
-		Circle circle;
-		AABB rectangle;
-		Color color;
-
-		static std::pair<FYC::Particle, World::ID> ToParticle(const SerializedParticle& serializedParticle);
-		static SerializedParticle ToSerializedParticle(const FYC::Particle& particle, World::ID id);
+	/**
+	 * Layout of the .fyc files, every field is little-endian and fixed-width, no padding is ever written.
+	 *
+	 * The file starts with a Header followed by SectionCount SectionEntry, each pointing to RecordCount records
+	 * of RecordSize bytes at Offset from the start of the file. Readers skip the sections they don't know
+	 * and the bytes past the fields they know at the end of a record, so newer files stay readable.
+	 * Reals are stored as IEEE 754 doubles whatever the Real of the build, the files are shared by every build.
+	 */
+	namespace LevelFormat {
+		inline constexpr std::array<char, 4> Magic{'F', 'Y', 'C', 'W'};
+		inline constexpr uint16_t Version = 1;
+		/// Magic of the deltas written by WorldSerializer::ToDelta, which share the header and the section table.
+		inline constexpr std::array<char, 4> DeltaMagic{'F', 'Y', 'C', 'D'};
+
+		/// Magic, Version, SectionCount, FileSize.
+		inline constexpr uint64_t HeaderSize = 4 + 2 + 2 + 8;
+		/// Type, RecordSize, RecordCount, Offset.
+		inline constexpr uint64_t SectionEntrySize = 4 + 4 + 8 + 8;
+
+		enum class Section : uint32_t {
+			/// One record, the min and max of the world bounds. Missing when the world is unbounded.
+			Bounds = 0x53444E42, // "BNDS"
+			/// One record per particle.
+			Particles = 0x54524150, // "PART"
+			/// One record, the side of the tiles of a chunked level. Missing when the level isn't chunked.
+			Tiling = 0x534C4954, // "TILS"
+			/// One record per tile of a chunked level, the particles of a tile are contiguous in the particles section.
+			Tiles = 0x454C4954, // "TILE"
+			/// One record per particle removed since the baseline of a delta, its ID.
+			Removed = 0x564D4552, // "REMV"
+			/// The change records of a delta, of variable size, as a single run of RecordCount records of one byte.
+			Changes = 0x474E4843, // "CHNG"
+		};
+
+		inline constexpr uint64_t BoundsRecordSize = 4 * 8;
+		inline constexpr uint64_t TilingRecordSize = 8;
+
+		/// Offsets of the fields of a particle record.
+		namespace ParticleField {
+			inline constexpr uint64_t Id = 0;
+			inline constexpr uint64_t Position = 8;
+			inline constexpr uint64_t Velocity = 24;
+			inline constexpr uint64_t ConstantAccelerations = 40;
+			inline constexpr uint64_t Rebound = 56;
+			inline constexpr uint64_t Drag = 64;
+			/// Radius of a circle, or width and height of a rectangle.
+			inline constexpr uint64_t ShapeSize = 72;
+			inline constexpr uint64_t ShapeType = 88;
+			inline constexpr uint64_t Flags = 89;
+			/// Red, green, blue and alpha.
+			inline constexpr uint64_t Color = 90;
+			/// Two bytes reserved, zero, to keep the records 8 bytes aligned.
+			inline constexpr uint64_t RecordSize = 96;
+		}
+
+		/// Offsets of the fields of a tile record.
+		namespace TileField {
+			/// Signed coordinates of the tile, the tile covers [X, X + 1) * tile size horizontally.
+			inline constexpr uint64_t X = 0;
+			inline constexpr uint64_t Y = 4;
+			inline constexpr uint64_t FirstParticle = 8;
+			inline constexpr uint64_t ParticleCount = 16;
+			/// Min and max of the shapes of the particles of the tile, which may stick out of the tile.
+			inline constexpr uint64_t Bounds = 24;
+			inline constexpr uint64_t RecordSize = 56;
+		}
+
+		/**
+		 * Offsets of the fields of a change record, then sizes of the fields following them for every bit of the mask set, in the order of the bits.
+		 * A created particle has every bit set and is followed by its color.
+		 */
+		namespace ChangeField {
+			inline constexpr uint64_t Id = 0;
+			/// A ParticleChange mask.
+			inline constexpr uint64_t Mask = 8;
+			inline constexpr uint64_t Fields = 9;
+
+			inline constexpr uint64_t PositionSize = 16;
+			inline constexpr uint64_t VelocitySize = 16;
+			inline constexpr uint64_t AccelerationsSize = 16;
+			/// Rebound and drag.
+			inline constexpr uint64_t MaterialSize = 16;
+			/// The ParticleFlags.
+			inline constexpr uint64_t StateSize = 1;
+			/// The ShapeType then the size of the shape.
+			inline constexpr uint64_t ShapeSize = 1 + 16;
+			inline constexpr uint64_t ColorSize = 4;
+		}
+
+		enum class ShapeType : uint8_t { Circle = 0, Rectangle = 1 };
+
+		enum ParticleFlags : uint8_t {
+			Kinematic = 1 << 0,
+			Awake = 1 << 1,
+			Bullet = 1 << 2,
+			Sensor = 1 << 3,
+		};
+	}
+
+	/// Sections of a validated .fyc file, pointing into its content.
+	struct LevelView {
+		const char* Bounds = nullptr;
+		const char* Particles = nullptr;
+		uint64_t ParticleRecordSize = 0;
+		uint64_t ParticleCount = 0;
+		/// Side of the tiles, 0 when the level isn't chunked.
+		Real TileSize{0};
+		const char* Tiles = nullptr;
+		uint64_t TileRecordSize = 0;
+		uint64_t TileCount = 0;
 	};
 
-	struct SerializedBounds {
-		AABB bounds;
-		bool hasBounds;
+	struct LevelTile {
+		int32_t X;
+		int32_t Y;
+		uint64_t FirstParticle;
+		uint64_t ParticleCount;
+		AABB Bounds;
 	};
 
 	class WorldSerializer {
 	public:
-		static std::vector<char> ToBinary(World world);
-		static World FromBinary(const std::vector<char>& binary);
+		static std::vector<char> ToBinary(const World& world);
+
+		/**
+		 * Encode the world as a chunked level, the particles grouped by the square tile holding their position.
+		 * The file stays a valid level for FromBinary, which loads every tile at once.
+		 */
+		static std::vector<char> ToChunkedBinary(const World& world, Real tileSize);
+
+		/**
+		 * Decode a .fyc file, or the raw structs written before the format was versioned.
+		 * @param binary The content of the file
+		 * @param world The world replaced by the decoded one, left untouched on failure
+		 * @return Whether the file was decoded, it isn't when truncated, malformed or of a newer version
+		 */
+		static bool FromBinary(std::span<const char> binary, World& world);
+
+		/**
+		 * Validate the header and the section table of a versioned file, without decoding any particle.
+		 * @return Whether the file is valid, every record of the view is then inside the binary
+		 */
+		static bool ReadLevel(std::span<const char> binary, LevelView& level);
+		[[nodiscard]] static LevelTile ReadTile(const LevelView& level, uint64_t index);
+		/// Decode a particle record of the level, its color goes in the user data.
+		static World::ID ReadParticle(const LevelView& level, uint64_t index, Particle& particle);
+
+		/**
+		 * Encode the particles changed and removed since the last World::ClearChanges, the caller then clears them to start the next delta.
+		 * Only the parts of a particle that changed are written, its user data only when it was created. The bounds aren't part of a delta.
+		 * A delta is meant for displaying or replicating a world stepped elsewhere: the previous position, the time asleep and the accelerations
+		 * summed for the next step aren't written, so a receiving world that steps on its own diverges from the sender.
+		 */
+		static std::vector<char> ToDelta(const World& world);
+
+		/**
+		 * Apply a delta to a world holding the state of its baseline, the particles are updated in place.
+		 * The changes of particles the world doesn't have are skipped.
+		 * @return Whether the delta was applied, a truncated or malformed delta is rejected before anything is changed
+		 */
+		static bool ApplyDelta(std::span<const char> binary, World& world);
+	private:
+		static std::vector<char> Encode(const World& world, Real tileSize);
+		static bool FromLegacyBinary(std::span<const char> binary, World& world);
 	};
 
 }
@@ -10,6 +10,7 @@
 #include <rlImGui.h>
 #include "ImGuiLib.hpp"
 #include "WorldSerializer.hpp"
+#include "MappedFile.hpp"
 
 using namespace FYC::Literal;
 
@@ -17,8 +18,8 @@ using namespace FYC::Literal;
 #include <emscripten/emscripten.h>
 #endif
 
-Application::Application(int width, int height, const std::string &name, bool isEditing)
-	: m_IsEditing(isEditing), m_Width(width), m_Height(height), m_Camera(static_cast<FYC::Real>(m_Width), static_cast<FYC::Real>(m_Height), 30) {
+Application::Application(int width, int height, const std::string &name, bool isEditing, bool usePhysicsThread)
+	: m_IsEditing(isEditing), m_UsePhysicsThread(usePhysicsThread), m_Width(width), m_Height(height), m_Camera(static_cast<FYC::Real>(m_Width), static_cast<FYC::Real>(m_Height), 30) {
 	// Initialization
 	//--------------------------------------------------------------------------------------
 	SetConfigFlags(FLAG_WINDOW_RESIZABLE); // Window configuration flags
@@ -86,18 +87,16 @@ void Application::UpdateCharacter(FYC::Real stepTime) {
 	FYC::Particle* ptr = m_WorldPlay.GetParticle(m_CharacterController.MainCharacter);
 	if (!ptr) return;
 
-	FYC::Vec2 movement{0};
-	if (IsKeyDown(m_CharacterController.LeftKey)) movement.x -= 1;
-	if (IsKeyDown(m_CharacterController.RightKey)) movement.x += 1;
-	if (movement.x != 0) {
-		ptr->AddAcceleration(movement * m_CharacterController.MovementAcceleration);
+	if (m_CharacterInput.Movement.x != 0) {
+		ptr->AddAcceleration(m_CharacterInput.Movement * m_CharacterController.MovementAcceleration);
 	}
 
-	if (IsKeyPressed(m_CharacterController.JumpKey) && m_CharacterController.CanJump) {
+	if (m_CharacterInput.Jump && m_CharacterController.CanJump) {
 		ptr->SubAcceleration({0, m_CharacterController.JumpImpulse / stepTime});
 		ptr->SetPosition(ptr->GetPosition() - FYC::Vec2{0,0.1});
 		m_CharacterController.CanJump = false;
 	}
+	m_CharacterInput.Jump = false;
 }
 
 void Application::UpdateEnemies(FYC::Real stepTime) {
@@ -142,14 +141,36 @@ void Application::UpdateLogic() {
 
 	if (m_PhysicsMode == PhysicsMode::Play) {
 		if (IsKeyPressed(KeyboardKey::KEY_E)) TryRestart();
-		float stepTime = std::min(GetFrameTime(), 1.0f);
 
-		UpdateCharacter(stepTime);
-		m_WorldPlay.Step(stepTime);
-		UpdateEnemies(stepTime);
+		CharacterInput input;
+		if (IsKeyDown(m_CharacterController.LeftKey)) input.Movement.x -= 1;
+		if (IsKeyDown(m_CharacterController.RightKey)) input.Movement.x += 1;
+		input.Jump = IsKeyPressed(m_CharacterController.JumpKey);
+
+		const FYC::World::Clock::duration stepBudget = m_StepBudgetMilliseconds > 0.0f
+			? std::chrono::duration_cast<FYC::World::Clock::duration>(std::chrono::duration<float, std::milli>(m_StepBudgetMilliseconds))
+			: FYC::World::Clock::duration::max();
+
+		// The input and the settings reach the steps through the physics thread commands when it owns the world.
+		const auto applyInput = [this, input, stepBudget](FYC::World&) {
+			m_CharacterInput.Movement = input.Movement;
+			m_CharacterInput.Jump |= input.Jump;
+			m_StepDriver.SetStepBudget(stepBudget);
+		};
+		if (m_PhysicsThread.IsRunning()) {
+			m_PhysicsThread.Post(applyInput);
+		} else {
+			applyInput(m_WorldPlay);
+		}
+		UpdateLevelStreaming();
+		if (!m_PhysicsThread.IsRunning()) {
+			m_StepDriver.Update(m_WorldPlay, GetFrameTime(), [this](const FYC::Real stepTime) { UpdateCharacter(stepTime); });
+		}
 
 		if (m_ShouldStop) {
 			Stop();
+		} else if (m_ShouldRestart) {
+			Restart();
 		}
 	}
 
@@ -159,24 +180,42 @@ void Application::UpdateLogic() {
 }
 
 void Application::UpdateRendering() {
-	for (const auto& particle : GetWorld()) {
-		if (particle.Data.type() != typeid(Color)) continue;
-		auto pos = particle.GetPosition();
-
-		static_assert(std::is_same<FYC::Particle::Shape, std::variant<FYC::Circle, FYC::AABB>>());
-
-		if (FYC::Circle circle; particle.HasShape<FYC::Circle>(circle)) {
-			DrawCircleV({pos.x, pos.y}, circle.Radius, std::any_cast<Color>(particle.Data));
-		} else if (FYC::AABB rectangle; particle.HasShape<FYC::AABB>(rectangle)) {
-			const auto size = rectangle.GetSize();
-			DrawRectangleV({rectangle.Min.x, rectangle.Min.y}, {size.x, size.y}, std::any_cast<Color>(particle.Data));
+	const std::variant<std::monostate, FYC::AABB>* bounds = &GetWorld().Bounds;
+	if (m_PhysicsThread.IsRunning()) {
+		// The physics thread owns the world, only its last published snapshot can be read.
+		const FYC::Application::RenderSnapshot& snapshot = m_PhysicsThread.GetSnapshot();
+		const FYC::Real alpha = snapshot.GetAlpha(FYC::World::Clock::now());
+		for (const FYC::Application::RenderParticle& particle : snapshot.Particles) {
+			DrawShape(particle.Shape, particle.PreviousPosition * (1_r - alpha) + particle.Position * alpha, particle.Tint);
+		}
+		bounds = &snapshot.Bounds;
+	} else {
+		FYC::World& world = GetWorld();
+		for (auto it = world.begin(); it != world.end(); ++it) {
+			const FYC::Particle& particle = *it;
+			if (particle.Data.type() != typeid(Color)) continue;
+			// The play world is drawn between its two last fixed steps so the motion stays smooth at any frame rate.
+			const auto pos = IsEdit() ? particle.GetPosition() : m_StepDriver.GetInterpolatedPosition(it.GetID(), particle);
+			DrawShape(particle.GetShape(), pos, std::any_cast<Color>(particle.Data));
 		}
 	}
 
-	if (const FYC::AABB* aabb = std::get_if<FYC::AABB>(&GetWorld().Bounds)) {
+	if (const FYC::AABB* aabb = std::get_if<FYC::AABB>(bounds)) {
 		const auto size = aabb->GetSize();
 		constexpr float linethick = 0.05;
-		DrawRectangleLinesEx(Rectangle{aabb->Min.x - linethick, aabb->Min.y - linethick, size.x + (linethick * 2), size.y + (linethick * 2)}, linethick, {0,180, 0, 160});
+		DrawRectangleLinesEx(Rectangle{static_cast<float>(aabb->Min.x) - linethick, static_cast<float>(aabb->Min.y) - linethick, static_cast<float>(size.x) + (linethick * 2), static_cast<float>(size.y) + (linethick * 2)}, linethick, {0,180, 0, 160});
+	}
+}
+
+void Application::DrawShape(const FYC::Particle::Shape& shape, const FYC::Vec2 position, const Color color) {
+	static_assert(std::is_same<FYC::Particle::Shape, std::variant<FYC::Circle, FYC::AABB>>());
+
+	if (const FYC::Circle* circle = std::get_if<FYC::Circle>(&shape)) {
+		DrawCircleV({static_cast<float>(position.x), static_cast<float>(position.y)}, static_cast<float>(circle->Radius), color);
+	} else if (const FYC::AABB* rectangle = std::get_if<FYC::AABB>(&shape)) {
+		const auto size = rectangle->GetSize();
+		const auto min = position - rectangle->GetHalfSize();
+		DrawRectangleV({static_cast<float>(min.x), static_cast<float>(min.y)}, {static_cast<float>(size.x), static_cast<float>(size.y)}, color);
 	}
 }
 
@@ -185,10 +224,10 @@ void Application::ClearWorld() {
 }
 
 void Application::LoadWorld(const std::filesystem::path& filepath) {
-	std::ifstream file(filepath, std::ios::in  | std::ios::binary);
+	// Decoded straight from the mapped pages, the file is never copied in memory first.
+	const FYC::Application::MappedFile file(filepath);
 	if (file) {
-		std::vector<char> binary((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-		m_WorldPlay = m_WorldEdit = FYC::Application::WorldSerializer::FromBinary(binary);
+		if (FYC::Application::WorldSerializer::FromBinary(file.GetData(), m_WorldEdit)) m_WorldPlay = m_WorldEdit;
 	}
 }
 
@@ -200,6 +239,27 @@ void Application::SaveWorld(const std::filesystem::path& filename) const {
 	}
 }
 
+void Application::SaveStreamedWorld(const std::filesystem::path& filename) const {
+	std::ofstream file(filename, std::ios::out  | std::ios::binary | std::ios::trunc);
+	if (file) {
+		const std::vector<char> binary = FYC::Application::WorldSerializer::ToChunkedBinary(m_WorldEdit, c_StreamedTileSize);
+		file.write(binary.data(), binary.size());
+	}
+}
+
+void Application::UpdateLevelStreaming() {
+	if (!m_LevelStreamer.IsOpen()) return;
+
+	// The tiles follow the character, or the camera when there is none.
+	const FYC::Vec2 cameraPosition = m_Camera.GetPosition();
+	const auto stream = [this, cameraPosition](FYC::World& world) {
+		const FYC::Particle* character = world.GetParticle(m_CharacterController.MainCharacter);
+		m_LevelStreamer.Update(world, character ? character->GetPosition() : cameraPosition);
+	};
+	if (m_PhysicsThread.IsRunning()) m_PhysicsThread.Post(stream);
+	else stream(m_WorldPlay);
+}
+
 void Application::ClearCharacter() {
 	m_CharacterController = {};
 }
@@ -339,33 +399,75 @@ void Application::TryPlay()
 
 void Application::TryRestart()
 {
-	TryStop();
-	TryPlay();
+	m_ShouldRestart = true;
 }
 
 void Application::Stop() {
+	m_PhysicsThread.Stop();
+	m_LevelStreamer.Close();
 	m_PhysicsMode = PhysicsMode::Edit;
 	m_ShouldStop = false;
-	m_WorldPlay.RemoveAllCallback();
+	m_ShouldRestart = false;
+	m_WorldPlay.RemoveAllCollisionListeners();
+	m_WorldPlay.RemoveAllContactListeners();
+	m_WorldPlay.RemoveAllSensorListeners();
 }
 
 void Application::Pause(bool isPause) {
 	m_PhysicsMode = isPause ? PhysicsMode::Pause : PhysicsMode::Play;
+	// A paused world goes back to the main thread so it can be edited.
+	if (isPause) m_PhysicsThread.Stop();
+	else if (m_UsePhysicsThread) StartPhysicsThread();
 }
 
 void Application::Play() {
+	m_PhysicsThread.Stop();
 	m_PhysicsMode = PhysicsMode::Play;
 	m_WorldPlay = m_WorldEdit;
+	m_StepDriver.Reset();
+	m_CharacterInput = {};
 	m_ShouldPlay = false;
+	m_ShouldRestart = false;
 	m_HasWon = false;
-	if(m_WorldPlay.GetParticle(m_CharacterController.MainCharacter)) m_WorldPlay.SetCallback(m_CharacterController.MainCharacter, [this](FYC::World::WorldIterator particle, FYC::World::WorldIterator other, FYC::Collision collision){OnCollision(particle, other, collision);});
+	if (FYC::Particle* character = m_WorldPlay.GetParticle(m_CharacterController.MainCharacter)) character->SetBullet(true);
+	// The character contacts are only needed when they start, and while they last to know whether the character stands on something.
+	if (m_WorldPlay.GetParticle(m_CharacterController.MainCharacter)) m_WorldPlay.AddContactListener([this](std::span<const FYC::World::ContactEvent> events){OnContacts(events);}, {.End = false});
+	// The deadly platforms only need to know the character touched them, they are overlap tested instead of solved.
+	for (const FYC::World::ID id : m_DeadlyPlatform) {
+		if (FYC::Particle* platform = m_WorldPlay.GetParticle(id)) platform->SetSensor(true);
+	}
+	m_WorldPlay.AddSensorListener([this](std::span<const FYC::World::SensorEvent> events){OnSensors(events);});
+	// The enemies only look up their own particles and set their velocities, at the end of every step.
+	m_WorldPlay.GetStepGraph().AddStage({"Enemies", FYC::StepResource::Structure | FYC::StepResource::Velocities, FYC::StepResource::Velocities | FYC::StepResource::Awake,
+		[this](FYC::World&, const FYC::Real stepTime) { UpdateEnemies(stepTime); }});
+	m_PlaySnapshot = m_WorldPlay.TakeSnapshot();
+	// The streamed tiles are added after the snapshot, the restarts remove them with the rest of what the steps changed.
+	// The file stays mapped until Stop closes it, saving the streamed world is only safe because it is disabled outside of the edit mode.
+	m_LevelStreamer.Open(c_StreamedWorldFilePath);
+	if (m_UsePhysicsThread) StartPhysicsThread();
+}
+
+void Application::Restart() {
+	m_PhysicsThread.Stop();
+	// The listeners and the stages Play added are kept, only what the steps changed goes back.
+	m_WorldPlay.Restore(m_PlaySnapshot);
+	m_LevelStreamer.Reset();
+	m_StepDriver.Reset();
+	m_CharacterInput = {};
+	m_ShouldRestart = false;
+	m_HasWon = false;
+	if (m_UsePhysicsThread) StartPhysicsThread();
+}
+
+void Application::StartPhysicsThread() {
+	m_PhysicsThread.Start(m_WorldPlay, m_StepDriver, [this](const FYC::Real stepTime) { UpdateCharacter(stepTime); }, {});
 }
 
 bool Application::RenderImGuiCamera() {
 	ImGui::SetNextWindowSize({300, 200}, ImGuiCond_Once);
 	ImGui::Begin("Camera"); {
 		FYC::Vec2 pos = m_Camera.GetPosition();
-		if (ImGuiLib::DragReal2("Position", pos.data, 0.1)) {
+		if (ImGuiLib::DragReal2("Position", pos, 0.1)) {
 			m_Camera.SetPosition(pos);
 		}
 
@@ -464,18 +566,18 @@ Application::ImGuiParticleResult Application::RenderImGuiParticle(FYC::World::Wo
 		particle.SetKinematic(isKinematic);
 		result.hasChanged = true;
 	}
-	if (ImGuiLib::DragReal2("Position", position.data, 0.1)) {
+	if (ImGuiLib::DragReal2("Position", position, 0.1)) {
 		particle.SetPosition(position);
 		result.hasChanged = true;
 	}
 	if (isKinematic) {
 		auto velocity = particle.GetVelocity();
-		if (ImGuiLib::DragReal2("Velocity", velocity.data, 0.1)) {
+		if (ImGuiLib::DragReal2("Velocity", velocity, 0.1)) {
 			particle.SetVelocity(velocity);
 			result.hasChanged = true;
 		}
 		FYC::Vec2 acc = particle.GetConstantAccelerations();
-		if (ImGuiLib::DragReal2("Acceleration", acc.data, 0.1)) {
+		if (ImGuiLib::DragReal2("Acceleration", acc, 0.1)) {
 			particle.SetConstantAcceleration(acc);
 			result.hasChanged = true;
 		}
@@ -505,7 +607,7 @@ Application::ImGuiParticleResult Application::RenderImGuiParticle(FYC::World::Wo
 		}
 	} else if (auto maybeSize = particle.GetRectangleSize()) {
 		FYC::Vec2 size = maybeSize.value();
-		if (ImGuiLib::DragReal2("Size", size.data, 0.01, 0.01, REAL_MAX, "%.2f")) {
+		if (ImGuiLib::DragReal2("Size", size, 0.01, 0.01, REAL_MAX, "%.2f")) {
 			particle.TrySetRectangleSize(size);
 			result.hasChanged = true;
 		}
@@ -545,6 +647,10 @@ bool Application::RenderImGuiPhysics() {
 		if (ImGui::Button("Clear")) {
 			ClearWorld();
 		}
+
+		if (ImGui::Button("Save Streamed")) {
+			SaveStreamedWorld(c_StreamedWorldFilePath);
+		}
 		ImGui::EndDisabled();
 
 		if (m_PhysicsMode != PhysicsMode::Edit) {
@@ -564,6 +670,69 @@ bool Application::RenderImGuiPhysics() {
 			}
 		}
 
+#if !defined(PLATFORM_WEB)
+		if (ImGui::Checkbox("Physics Thread", &m_UsePhysicsThread) && IsPlay()) {
+			if (m_UsePhysicsThread) StartPhysicsThread();
+			else m_PhysicsThread.Stop();
+		}
+#endif
+
+		if (m_PhysicsThread.IsRunning()) {
+			ImGui::TextWrapped("The physics thread owns the world, pause to edit it.");
+			const FYC::Application::RenderSnapshot& snapshot = m_PhysicsThread.GetSnapshot();
+			RenderImGuiStepStatistics(snapshot.Statistics);
+			RenderImGuiMemoryStats(snapshot.Memory, snapshot.PeakMemory, snapshot.PeakTotalMemory);
+			ImGui::End();
+			return false;
+		}
+
+		ImGui::Spacing();
+
+		{
+			FYC::SolverSettings& solver = GetWorld().Solver;
+			static constexpr const char* c_SolverNames[] {"Iterative", "Speculative", "Sequential Impulse", "Substepping"};
+			int solverType = static_cast<int>(solver.Type);
+			if (ImGui::Combo("Solver", &solverType, c_SolverNames, IM_ARRAYSIZE(c_SolverNames))) {
+				solver.Type = static_cast<FYC::SolverType>(solverType);
+			}
+			if (solver.Type != FYC::SolverType::Substepping) {
+				int iterations = static_cast<int>(solver.Iterations);
+				if (ImGui::DragInt("Solver Iterations", &iterations, 0.1f, 1, 100)) {
+					solver.Iterations = static_cast<uint32_t>(iterations);
+				}
+			}
+			if (solver.Type == FYC::SolverType::SequentialImpulse) {
+				ImGuiLib::DragReal("Solver Tolerance", &solver.Tolerance, 0.00001f, 0, 1, "%.5f");
+				ImGui::Checkbox("Warm Starting", &solver.WarmStarting);
+			}
+			if (solver.Type == FYC::SolverType::Substepping) {
+				int substeps = static_cast<int>(solver.Substeps);
+				if (ImGui::DragInt("Substeps", &substeps, 0.1f, 1, 64)) {
+					solver.Substeps = static_cast<uint32_t>(substeps);
+				}
+				ImGuiLib::DragReal("Contact Compliance", &solver.Compliance, 0.00001f, 0, 1, "%.5f");
+			}
+			int threadCount = static_cast<int>(solver.ThreadCount);
+			if (ImGui::DragInt("Physics Threads", &threadCount, 0.1f, 1, static_cast<int>(std::max(1u, std::thread::hardware_concurrency())))) {
+				solver.ThreadCount = static_cast<uint32_t>(threadCount);
+			}
+
+			ImGui::DragFloat("Step Budget (ms)", &m_StepBudgetMilliseconds, 0.01f, 0.0f, 100.0f, m_StepBudgetMilliseconds > 0.0f ? "%.2f" : "Unlimited");
+
+			int maxSteps = static_cast<int>(m_StepDriver.GetMaxStepsPerUpdate());
+			if (ImGui::DragInt("Max Steps Per Frame", &maxSteps, 0.1f, 1, 32)) {
+				m_StepDriver.SetMaxStepsPerUpdate(static_cast<uint32_t>(maxSteps));
+			}
+			ImGui::Text("Interpolation: %.2f, dropped time: %.2fs", static_cast<float>(m_StepDriver.GetAlpha()), static_cast<float>(m_StepDriver.GetDroppedTime()));
+
+			RenderImGuiStepStatistics(GetWorld().GetStepStatistics());
+			RenderImGuiMemoryStats(GetWorld().GetMemoryStats(), GetWorld().GetPeakMemoryStats(), GetWorld().GetPeakTotalMemory());
+			if (m_LevelStreamer.IsOpen()) {
+				ImGui::Text("Streamed tiles: %llu / %llu, %llu particles", static_cast<unsigned long long>(m_LevelStreamer.GetLoadedTileCount()),
+					static_cast<unsigned long long>(m_LevelStreamer.GetTileCount()), static_cast<unsigned long long>(m_LevelStreamer.GetLoadedParticleCount()));
+			}
+		}
+
 		ImGui::Spacing();
 
 		if (FYC::AABB* aabb = std::get_if<FYC::AABB>(&GetWorld().Bounds)) {
@@ -572,13 +741,13 @@ bool Application::RenderImGuiPhysics() {
 			} else {
 				bool changed = false;
 				bool posSizeChanged = false;
-				changed |= ImGuiLib::DragReal2("Min AABB", aabb->Min.data, 0.1);
-				changed |= ImGuiLib::DragReal2("Max AABB", aabb->Max.data, 0.1);
+				changed |= ImGuiLib::DragReal2("Min AABB", aabb->Min, 0.1);
+				changed |= ImGuiLib::DragReal2("Max AABB", aabb->Max, 0.1);
 				ImGui::Separator();
 				auto pos = aabb->GetCenter();
 				auto size = aabb->GetSize();
-				changed |= posSizeChanged |= ImGuiLib::DragReal2("Position AABB", pos.data, 0.1);
-				changed |= posSizeChanged |= ImGuiLib::DragReal2("Size AABB", size.data, 0.1);
+				changed |= posSizeChanged |= ImGuiLib::DragReal2("Position AABB", pos, 0.1);
+				changed |= posSizeChanged |= ImGuiLib::DragReal2("Size AABB", size, 0.1);
 				if (posSizeChanged) *aabb = FYC::AABB::FromCenterSize(pos, size);
 				if (changed) aabb->Validate();
 			}
@@ -705,31 +874,79 @@ bool Application::RenderImGuiEnemies() {
 	return changed;
 }
 
-void Application::OnCollision(FYC::World::WorldIterator particle, FYC::World::WorldIterator other, FYC::Collision collision) {
-	if (particle.GetID() != m_CharacterController.MainCharacter) return;
-
-	if (collision.HalfWayInterpenetratingPoint.y > particle->GetPosition().y)
-		m_CharacterController.CanJump = true;
+void Application::RenderImGuiStepStatistics(const FYC::StepStatistics& statistics) {
+	ImGui::Text("Step duration: %.3f ms", std::chrono::duration<double, std::milli>(statistics.Duration).count());
+	ImGui::Text("Detection passes: %u", statistics.DetectionPasses);
+	ImGui::Text("Solver iterations: %u", statistics.SolverIterations);
+	ImGui::Text("Contacts: %llu", static_cast<unsigned long long>(statistics.ContactCount));
+	ImGui::Text("Contact batches: %u", statistics.ContactBatches);
+#ifdef FYC_TRACK_ALLOCATIONS
+	ImGui::Text("Heap allocations: %llu", static_cast<unsigned long long>(statistics.HeapAllocations));
+#endif
+	if (statistics.IsDegraded()) {
+		ImGui::TextColored({1.0f, 0.6f, 0.0f, 1.0f}, "Over budget:%s%s%s%s",
+			statistics.SolverIterationsCut ? " iterations cut" : "",
+			statistics.SubstepsMerged ? " substeps merged" : "",
+			statistics.SleepDeferred ? " sleep deferred" : "",
+			statistics.WarmStartSkipped ? " warm start skipped" : "");
+	}
+}
+
+void Application::RenderImGuiMemoryStats(const FYC::MemoryStats& memory, const FYC::MemoryStats& peakMemory, const uint64_t peakTotalMemory) {
+	if (!ImGui::TreeNode("Memory")) return;
+	const auto row = [](const char* name, const uint64_t bytes, const uint64_t peakBytes) {
+		ImGui::Text("%s: %.1f KiB (peak %.1f KiB)", name, static_cast<double>(bytes) / 1024.0, static_cast<double>(peakBytes) / 1024.0);
+	};
+	row("Particles", memory.Particles, peakMemory.Particles);
+	row("Contacts", memory.Contacts, peakMemory.Contacts);
+	row("Events", memory.Events, peakMemory.Events);
+	row("Callbacks", memory.Callbacks, peakMemory.Callbacks);
+	row("Broadphase", memory.Broadphase, peakMemory.Broadphase);
+	row("Commands", memory.Commands, peakMemory.Commands);
+	row("Total", memory.GetTotal(), peakTotalMemory);
+	ImGui::TreePop();
+}
+
+void Application::OnContacts(std::span<const FYC::World::ContactEvent> events) {
+	const FYC::World::ID character = m_CharacterController.MainCharacter;
+	const FYC::Particle* particle = m_WorldPlay.GetParticle(character);
+	if (!particle) return;
+
+	for (const FYC::World::ContactEvent& event : events) {
+		if (event.IdA != character && event.IdB != character) continue;
+		const FYC::World::ID other = event.IdA == character ? event.IdB : event.IdA;
+
+		if (event.Contact.HalfWayInterpenetratingPoint.y > particle->GetPosition().y)
+			m_CharacterController.CanJump = true;
+
+		// The rules of the level only need to run once per contact.
+		if (event.Type != FYC::ContactEventType::Begin) continue;
+
+		if (other == FYC::World::NULL_ID) {
+			TryRestart();
+		}
 
-	if (other.GetID() == FYC::World::NULL_ID) {
-		TryRestart();
-	}
+		if (std::find(m_EnemyIds.begin(), m_EnemyIds.end(), other) != m_EnemyIds.end()) {
+			const FYC::Particle* enemy = m_WorldPlay.GetParticle(other);
+			if (enemy && enemy->GetPosition().y - particle->GetPosition().y > m_EnemyParameters.KillThreshold) {
+				m_WorldPlay.GetCommandBuffer().RemoveParticle(other);
+			} else {
+				TryRestart();
+			}
+		}
 
-	if (std::find(m_DeadlyPlatform.begin(), m_DeadlyPlatform.end(), other.GetID()) != m_DeadlyPlatform.end()) {
-		TryRestart();
+		if (other == m_EndPlatform) {
+			m_HasWon = true;
+		}
 	}
+}
 
-	if (std::find(m_EnemyIds.begin(), m_EnemyIds.end(), other.GetID()) != m_EnemyIds.end()) {
-		if (other->GetPosition().y - particle->GetPosition().y > m_EnemyParameters.KillThreshold) {
-			m_WorldPlay.RemoveParticle(other.GetID());
-		} else {
+void Application::OnSensors(std::span<const FYC::World::SensorEvent> events) {
+	for (const FYC::World::SensorEvent& event : events) {
+		if (event.Type == FYC::ContactEventType::Begin && event.OtherId == m_CharacterController.MainCharacter) {
 			TryRestart();
 		}
 	}
-
-	if (other.GetID() == m_EndPlatform) {
-		m_HasWon = true;
-	}
 }
 
 void Application::RenderImGui() {
@@ -738,9 +955,12 @@ void Application::RenderImGui() {
 
 	bool hasChanged = false;
 	hasChanged |= RenderImGuiCamera();
-	hasChanged |= RenderImGuiCharacter();
-	hasChanged |= RenderImGuiDeadlyPlatforms();
-	hasChanged |= RenderImGuiEnemies();
+	// These windows edit the world and the game state, which the physics thread owns while it runs.
+	if (!m_PhysicsThread.IsRunning()) {
+		hasChanged |= RenderImGuiCharacter();
+		hasChanged |= RenderImGuiDeadlyPlatforms();
+		hasChanged |= RenderImGuiEnemies();
+	}
 	hasChanged |= RenderImGuiPhysics();
 
 	if (hasChanged && IsEdit()) {
@@ -769,6 +989,7 @@ void Application::UpdateUI() {
 Application::~Application() {
 	// De-Initialization
 	//--------------------------------------------------------------------------------------
+	m_PhysicsThread.Stop();
 	rlImGuiShutdown(); // cleans up ImGui
 	CloseWindow(); // Close window and OpenGL context
 	//--------------------------------------------------------------------------------------
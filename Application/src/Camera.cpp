@@ -13,44 +13,44 @@ namespace FYC::Application {
 
 
 	Camera::Camera()
-		: m_Camera({{static_cast<float>(c_DefaultWidth)*c_CenterOffsetMultiplier,static_cast<float>(c_DefaultHeight)*c_CenterOffsetMultiplier},{0,0}, 0, static_cast<float>(c_DefaultHeight) * c_DefaultZoomMultiplier})
+		: m_Camera({{static_cast<float>(c_DefaultWidth*c_CenterOffsetMultiplier),static_cast<float>(c_DefaultHeight*c_CenterOffsetMultiplier)},{0,0}, 0, static_cast<float>(c_DefaultHeight * c_DefaultZoomMultiplier)})
 	{
 	}
 
 	Camera::Camera(Real viewportWidth, Real viewportHeight)
-	: m_Camera({{static_cast<float>(viewportWidth)*c_CenterOffsetMultiplier,static_cast<float>(viewportHeight)*c_CenterOffsetMultiplier},{0,0}, 0, static_cast<float>(viewportHeight) * c_DefaultZoomMultiplier})
+	: m_Camera({{static_cast<float>(viewportWidth*c_CenterOffsetMultiplier),static_cast<float>(viewportHeight*c_CenterOffsetMultiplier)},{0,0}, 0, static_cast<float>(viewportHeight * c_DefaultZoomMultiplier)})
 	{
 	}
 
 	Camera::Camera(Real viewportWidth, Real viewportHeight, Real zoom)
-	: m_Camera({{static_cast<float>(viewportWidth)*c_CenterOffsetMultiplier,static_cast<float>(viewportHeight)*c_CenterOffsetMultiplier},{0,0}, 0, zoom})
+	: m_Camera({{static_cast<float>(viewportWidth*c_CenterOffsetMultiplier),static_cast<float>(viewportHeight*c_CenterOffsetMultiplier)},{0,0}, 0, static_cast<float>(zoom)})
 	{
 	}
 
 
-	void Camera::SetViewport(Real width, Real height) {m_Camera.offset = {static_cast<float>(width)*c_CenterOffsetMultiplier,static_cast<float>(height)*c_CenterOffsetMultiplier};}
+	void Camera::SetViewport(Real width, Real height) {m_Camera.offset = {static_cast<float>(width*c_CenterOffsetMultiplier),static_cast<float>(height*c_CenterOffsetMultiplier)};}
 	void Camera::SetViewport(Real width, Real height, Real zoom) { SetViewport(width, height); SetZoom(zoom); }
 
 	void Camera::Move(const Vec2& movement)
 	{
-		m_Camera.target.x += movement.x;
-		m_Camera.target.y += movement.y;
+		m_Camera.target.x += static_cast<float>(movement.x);
+		m_Camera.target.y += static_cast<float>(movement.y);
 	}
 
 	void Camera::SetZoom(Real zoom)
 	{
-		m_Camera.zoom = zoom;
+		m_Camera.zoom = static_cast<float>(zoom);
 	}
 
 	void Camera::MultiplyZoom(Real multiplicator)
 	{
-		m_Camera.zoom *= multiplicator;
+		m_Camera.zoom *= static_cast<float>(multiplicator);
 	}
 
 	void Camera::SetPosition(const Vec2 &position)
 	{
-		m_Camera.target.x = position.x;
-		m_Camera.target.y = position.y;
+		m_Camera.target.x = static_cast<float>(position.x);
+		m_Camera.target.y = static_cast<float>(position.y);
 	}
 
 	Vec2 Camera::GetPosition() const {
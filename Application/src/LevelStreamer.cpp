@@ -0,0 +1,218 @@
+#include "LevelStreamer.hpp"
+
+namespace FYC::Application {
+
+	LevelStreamer::LevelStreamer() = default;
+
+	LevelStreamer::~LevelStreamer()
+	{
+		Close();
+	}
+
+	bool LevelStreamer::Open(const std::filesystem::path& filepath)
+	{
+		Close();
+		m_File = MappedFile(filepath);
+		if (!m_File || !WorldSerializer::ReadLevel(m_File.GetData(), m_Level) || !m_Level.Tiles) {
+			m_File = {};
+			m_Level = {};
+			return false;
+		}
+
+		m_Tiles.resize(m_Level.TileCount);
+		m_TileIndices.reserve(m_Level.TileCount);
+		m_TileOverhang = 0;
+		for (uint32_t i = 0; i < m_Level.TileCount; ++i) {
+			const LevelTile& tile = m_Tiles[i].Level = WorldSerializer::ReadTile(m_Level, i);
+			m_TileIndices[GetTileKey(tile.X, tile.Y)] = i;
+
+			const Vec2 min{static_cast<Real>(tile.X) * m_Level.TileSize, static_cast<Real>(tile.Y) * m_Level.TileSize};
+			const Vec2 max = min + Vec2{m_Level.TileSize};
+			m_TileOverhang = std::max({m_TileOverhang, min.x - tile.Bounds.Min.x, min.y - tile.Bounds.Min.y, tile.Bounds.Max.x - max.x, tile.Bounds.Max.y - max.y});
+		}
+
+		m_Stopping = false;
+		m_Thread = std::thread(&LevelStreamer::Loop, this);
+		return true;
+	}
+
+	void LevelStreamer::Close()
+	{
+		if (m_Thread.joinable()) {
+			{
+				std::lock_guard lock(m_Mutex);
+				m_Stopping = true;
+			}
+			m_Condition.notify_one();
+			m_Thread.join();
+		}
+		Reset();
+		m_Tiles.clear();
+		m_TileIndices.clear();
+		m_Level = {};
+		m_File = {};
+	}
+
+	bool LevelStreamer::IsOpen() const
+	{
+		return m_File.IsOpen();
+	}
+
+	void LevelStreamer::Reset()
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Requests.clear();
+			m_Decoded.clear();
+		}
+		m_Inserting.clear();
+		for (const uint32_t index : m_ActiveTiles) {
+			m_Tiles[index].State = TileState::Unloaded;
+			m_Tiles[index].Ids.clear();
+		}
+		m_ActiveTiles.clear();
+		m_LoadedTileCount = 0;
+		m_LoadedParticleCount = 0;
+	}
+
+	void LevelStreamer::Update(World& world, const Vec2& focus)
+	{
+		if (!IsOpen()) return;
+
+		std::vector<DecodedTile> decoded;
+		{
+			std::lock_guard lock(m_Mutex);
+			std::swap(decoded, m_Decoded);
+		}
+		// A tile that went far while being decoded was cancelled, or queued again and already added.
+		for (DecodedTile& tile : decoded) {
+			if (m_Tiles[tile.Index].State != TileState::Queued) continue;
+			m_Tiles[tile.Index].State = TileState::Inserting;
+			m_Inserting.push_back(std::move(tile));
+		}
+
+		std::erase_if(m_ActiveTiles, [this, &world, &focus](const uint32_t index) {
+			Tile& tile = m_Tiles[index];
+			if (GetDistance(tile.Level.Bounds, focus) <= Settings.UnloadDistance) return false;
+			if (tile.State == TileState::Queued) {
+				std::lock_guard lock(m_Mutex);
+				std::erase(m_Requests, index);
+			} else if (tile.State == TileState::Inserting) {
+				std::erase_if(m_Inserting, [index](const DecodedTile& inserting) { return inserting.Index == index; });
+			} else {
+				--m_LoadedTileCount;
+			}
+			RemoveTile(world, tile);
+			return true;
+		});
+
+		// Only the tiles whose square, grown by the overhang, is within reach can be close enough.
+		std::vector<uint32_t> requests;
+		const Real reach = Settings.LoadDistance + m_TileOverhang;
+		// Wider than the coordinates, the loops end even at the last one.
+		for (int64_t y = GetTileCoordinate(focus.y - reach); y <= GetTileCoordinate(focus.y + reach); ++y) {
+			for (int64_t x = GetTileCoordinate(focus.x - reach); x <= GetTileCoordinate(focus.x + reach); ++x) {
+				const auto it = m_TileIndices.find(GetTileKey(static_cast<int32_t>(x), static_cast<int32_t>(y)));
+				if (it == m_TileIndices.end()) continue;
+				Tile& tile = m_Tiles[it->second];
+				if (tile.State != TileState::Unloaded || GetDistance(tile.Level.Bounds, focus) > Settings.LoadDistance) continue;
+				tile.State = TileState::Queued;
+				m_ActiveTiles.push_back(it->second);
+				requests.push_back(it->second);
+			}
+		}
+
+		if (!requests.empty()) {
+			{
+				std::lock_guard lock(m_Mutex);
+				m_Requests.insert(m_Requests.end(), requests.begin(), requests.end());
+			}
+			m_Condition.notify_one();
+		}
+
+		// The particles are added in batches, so a burst of tiles doesn't stall a frame.
+		uint64_t budget = Settings.ParticlesPerUpdate > 0 ? Settings.ParticlesPerUpdate : UINT64_MAX;
+		while (budget > 0 && !m_Inserting.empty()) {
+			DecodedTile& inserting = m_Inserting.front();
+			Tile& tile = m_Tiles[inserting.Index];
+			const uint64_t begin = tile.Ids.size();
+			const uint64_t end = std::min<uint64_t>(inserting.Particles.size(), begin + budget);
+			for (uint64_t i = begin; i < end; ++i) tile.Ids.push_back(world.AddParticle(std::move(inserting.Particles[i])).GetID());
+			budget -= end - begin;
+			m_LoadedParticleCount += end - begin;
+
+			if (end == inserting.Particles.size()) {
+				tile.State = TileState::Loaded;
+				++m_LoadedTileCount;
+				m_Inserting.pop_front();
+			}
+		}
+	}
+
+	uint64_t LevelStreamer::GetTileCount() const
+	{
+		return m_Tiles.size();
+	}
+
+	uint64_t LevelStreamer::GetLoadedTileCount() const
+	{
+		return m_LoadedTileCount.load(std::memory_order_relaxed);
+	}
+
+	uint64_t LevelStreamer::GetLoadedParticleCount() const
+	{
+		return m_LoadedParticleCount.load(std::memory_order_relaxed);
+	}
+
+	void LevelStreamer::Loop()
+	{
+		while (true) {
+			uint32_t index;
+			{
+				std::unique_lock lock(m_Mutex);
+				m_Condition.wait(lock, [this] { return m_Stopping || !m_Requests.empty(); });
+				if (m_Stopping) return;
+				index = m_Requests.front();
+				m_Requests.pop_front();
+			}
+
+			// The tile records never change once the level is open, they are read without the lock.
+			const LevelTile& level = m_Tiles[index].Level;
+			DecodedTile tile{index, {}};
+			tile.Particles.resize(level.ParticleCount);
+			for (uint64_t i = 0; i < level.ParticleCount; ++i) {
+				WorldSerializer::ReadParticle(m_Level, level.FirstParticle + i, tile.Particles[i]);
+			}
+
+			std::lock_guard lock(m_Mutex);
+			m_Decoded.push_back(std::move(tile));
+		}
+	}
+
+	void LevelStreamer::RemoveTile(World& world, Tile& tile)
+	{
+		for (const World::ID id : tile.Ids) world.RemoveParticle(id);
+		m_LoadedParticleCount -= tile.Ids.size();
+		tile.Ids.clear();
+		tile.State = TileState::Unloaded;
+	}
+
+	int32_t LevelStreamer::GetTileCoordinate(const Real position) const
+	{
+		// Clamped, a coordinate out of the range of int32 can't be cast.
+		const double coordinate = std::floor(static_cast<double>(position) / static_cast<double>(m_Level.TileSize));
+		return static_cast<int32_t>(std::clamp(coordinate, static_cast<double>(INT32_MIN), static_cast<double>(INT32_MAX)));
+	}
+
+	uint64_t LevelStreamer::GetTileKey(const int32_t x, const int32_t y)
+	{
+		return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+	}
+
+	Real LevelStreamer::GetDistance(const AABB& bounds, const Vec2& point)
+	{
+		const Vec2 closest{Math::Clamp(point.x, bounds.Min.x, bounds.Max.x), Math::Clamp(point.y, bounds.Min.y, bounds.Max.y)};
+		return Math::Magnitude(point - closest);
+	}
+
+} // FYC::Application
@@ -0,0 +1,109 @@
+#include "MappedFile.hpp"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace FYC::Application {
+
+	MappedFile::MappedFile(const std::filesystem::path& filepath)
+	{
+#if defined(_WIN32)
+		const HANDLE file = CreateFileW(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file != INVALID_HANDLE_VALUE) {
+			LARGE_INTEGER size;
+			if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+				// The view keeps the mapping alive, both handles can be closed once it is made.
+				const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				if (mapping) {
+					m_Mapping = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+					m_Size = static_cast<uint64_t>(size.QuadPart);
+					CloseHandle(mapping);
+				}
+			}
+			CloseHandle(file);
+		}
+#else
+		const int file = open(filepath.c_str(), O_RDONLY);
+		if (file >= 0) {
+			struct stat status{};
+			if (fstat(file, &status) == 0 && status.st_size > 0) {
+				void* mapping = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+				if (mapping != MAP_FAILED) {
+					// Files are decoded front to back, let the kernel read ahead.
+					madvise(mapping, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+					m_Mapping = static_cast<const char*>(mapping);
+					m_Size = static_cast<uint64_t>(status.st_size);
+				}
+			}
+			close(file);
+		}
+#endif
+		if (m_Mapping) {
+			m_IsOpen = true;
+			return;
+		}
+
+		m_Size = 0;
+		std::ifstream stream(filepath, std::ios::in | std::ios::binary | std::ios::ate);
+		if (!stream) return;
+		m_Buffer.resize(static_cast<uint64_t>(stream.tellg()));
+		stream.seekg(0);
+		stream.read(m_Buffer.data(), static_cast<std::streamsize>(m_Buffer.size()));
+		m_IsOpen = static_cast<bool>(stream);
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept :
+		m_Mapping(std::exchange(other.m_Mapping, nullptr)),
+		m_Size(std::exchange(other.m_Size, 0)),
+		m_Buffer(std::move(other.m_Buffer)),
+		m_IsOpen(std::exchange(other.m_IsOpen, false))
+	{
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other) {
+			Close();
+			m_Mapping = std::exchange(other.m_Mapping, nullptr);
+			m_Size = std::exchange(other.m_Size, 0);
+			m_Buffer = std::move(other.m_Buffer);
+			m_IsOpen = std::exchange(other.m_IsOpen, false);
+		}
+		return *this;
+	}
+
+	std::span<const char> MappedFile::GetData() const
+	{
+		if (m_Mapping) return {m_Mapping, m_Size};
+		return {m_Buffer.data(), m_Buffer.size()};
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Mapping) {
+#if defined(_WIN32)
+			UnmapViewOfFile(m_Mapping);
+#else
+			munmap(const_cast<char*>(m_Mapping), m_Size);
+#endif
+		}
+		m_Mapping = nullptr;
+		m_Size = 0;
+		m_Buffer.clear();
+		m_IsOpen = false;
+	}
+
+} // FYC::Application
@@ -0,0 +1,110 @@
+#include "PhysicsThread.hpp"
+
+namespace FYC::Application {
+
+	Real RenderSnapshot::GetAlpha(const World::Clock::time_point now) const
+	{
+		if (FixedStepTime <= 0) return 1;
+		const Real elapsed = static_cast<Real>(std::chrono::duration<float>(now - StepTime).count());
+		return Math::Clamp(elapsed / FixedStepTime, 0, 1);
+	}
+
+	PhysicsThread::PhysicsThread() = default;
+
+	PhysicsThread::~PhysicsThread()
+	{
+		Stop();
+	}
+
+	void PhysicsThread::Start(World& world, StepDriver& driver, StepDriver::StepCallback beforeStep, StepDriver::StepCallback afterStep)
+	{
+		Stop();
+		m_World = &world;
+		m_Driver = &driver;
+		m_BeforeStep = std::move(beforeStep);
+		m_AfterStep = std::move(afterStep);
+
+		// The first snapshot is published before the thread starts, so there is always one to draw.
+		Capture(world, driver, m_Snapshots.GetWriteBuffer());
+		m_Snapshots.Publish();
+
+		m_Stopping = false;
+		m_Thread = std::thread(&PhysicsThread::Loop, this);
+	}
+
+	void PhysicsThread::Stop()
+	{
+		if (!m_Thread.joinable()) return;
+		m_Stopping = true;
+		m_Thread.join();
+
+		// Commands left behind still belong to the world, they run now that the main thread owns it again.
+		RunCommands();
+	}
+
+	bool PhysicsThread::IsRunning() const
+	{
+		return m_Thread.joinable();
+	}
+
+	void PhysicsThread::Post(Command command)
+	{
+		std::lock_guard lock(m_CommandsMutex);
+		m_Commands.push_back(std::move(command));
+	}
+
+	const RenderSnapshot& PhysicsThread::GetSnapshot()
+	{
+		m_Snapshots.Update();
+		return m_Snapshots.GetReadBuffer();
+	}
+
+	void PhysicsThread::Capture(World& world, const StepDriver& driver, RenderSnapshot& snapshot)
+	{
+		snapshot.Particles.clear();
+		for (auto it = world.begin(); it != world.end(); ++it) {
+			const Particle& particle = *it;
+			if (particle.Data.type() != typeid(Color)) continue;
+			snapshot.Particles.push_back({driver.GetPreviousPosition(it.GetID(), particle), particle.GetPosition(), particle.GetShape(), std::any_cast<Color>(particle.Data)});
+		}
+		snapshot.Bounds = world.Bounds;
+		snapshot.Statistics = world.GetStepStatistics();
+		snapshot.Memory = world.GetMemoryStats();
+		snapshot.PeakMemory = world.GetPeakMemoryStats();
+		snapshot.PeakTotalMemory = world.GetPeakTotalMemory();
+		snapshot.StepTime = World::Clock::now();
+		snapshot.FixedStepTime = driver.GetFixedStepTime();
+	}
+
+	void PhysicsThread::Loop()
+	{
+		World::Clock::time_point lastUpdate = World::Clock::now();
+		while (!m_Stopping) {
+			RunCommands();
+
+			const World::Clock::time_point now = World::Clock::now();
+			const auto elapsedTime = static_cast<Real>(std::chrono::duration<float>(now - lastUpdate).count());
+			lastUpdate = now;
+
+			if (m_Driver->Update(*m_World, elapsedTime, m_BeforeStep, m_AfterStep) > 0) {
+				Capture(*m_World, *m_Driver, m_Snapshots.GetWriteBuffer());
+				m_Snapshots.Publish();
+			}
+
+			// Sleep until the accumulated time covers the next step.
+			const auto untilNextStep = std::chrono::duration<float>(static_cast<float>((Real{1} - m_Driver->GetAlpha()) * m_Driver->GetFixedStepTime()));
+			std::this_thread::sleep_for(std::max(untilNextStep, std::chrono::duration<float>(0.001f)));
+		}
+	}
+
+	void PhysicsThread::RunCommands()
+	{
+		{
+			std::lock_guard lock(m_CommandsMutex);
+			std::swap(m_Commands, m_RunningCommands);
+		}
+		for (const Command& command : m_RunningCommands) command(*m_World);
+		m_RunningCommands.clear();
+	}
+
+} // FYC::Application
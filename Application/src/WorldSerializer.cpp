@@ -6,84 +6,645 @@
 
 namespace FYC::Application {
 
-	// ========== SerializedParticle ==========
-	std::pair<FYC::Particle, World::ID> SerializedParticle::ToParticle(const SerializedParticle& serialization)
+	namespace {
+
+		/// Layout of the files written before the format was versioned, raw structs of the build that wrote them.
+		struct LegacyParticle {
+			enum Shape : uint8_t {CIRCLE, RECTANGLE};
+			World::ID id;
+			Vec2 position;
+			Vec2 velocity;
+			Vec2 constantAccelerations;
+			Real rebound;
+			Real drag;
+			bool isKinematic;
+			bool isAwake;
+			Shape shapeType;
+			Circle circle;
+			AABB rectangle;
+			Color color;
+		};
+
+		struct LegacyBounds {
+			AABB bounds;
+			bool hasBounds;
+		};
+
+		template<typename T>
+		void WriteLittleEndian(char* destination, T value)
+		{
+			static_assert(std::is_unsigned_v<T>);
+			if constexpr (std::endian::native == std::endian::little) {
+				std::memcpy(destination, &value, sizeof(T));
+			} else {
+				for (uint64_t i = 0; i < sizeof(T); ++i) destination[i] = static_cast<char>((value >> (i * 8)) & 0xFF);
+			}
+		}
+
+		template<typename T>
+		[[nodiscard]] T ReadLittleEndian(const char* source)
+		{
+			static_assert(std::is_unsigned_v<T>);
+			T value;
+			if constexpr (std::endian::native == std::endian::little) {
+				std::memcpy(&value, source, sizeof(T));
+			} else {
+				value = 0;
+				for (uint64_t i = 0; i < sizeof(T); ++i) value |= static_cast<T>(static_cast<uint8_t>(source[i])) << (i * 8);
+			}
+			return value;
+		}
+
+		void WriteReal(char* destination, const Real value)
+		{
+			WriteLittleEndian(destination, std::bit_cast<uint64_t>(static_cast<double>(value)));
+		}
+
+		void WriteVec2(char* destination, const Vec2& value)
+		{
+			WriteReal(destination, value.x);
+			WriteReal(destination + 8, value.y);
+		}
+
+		[[nodiscard]] double ReadDouble(const char* source)
+		{
+			return std::bit_cast<double>(ReadLittleEndian<uint64_t>(source));
+		}
+
+		[[nodiscard]] Real ReadReal(const char* source)
+		{
+			return static_cast<Real>(ReadDouble(source));
+		}
+
+		[[nodiscard]] Vec2 ReadVec2(const char* source)
+		{
+			return {ReadReal(source), ReadReal(source + 8)};
+		}
+
+		void WriteShape(char* type, char* size, const Particle& particle)
+		{
+			using namespace LevelFormat;
+			Circle circle;
+			if (particle.HasShape<Circle>(circle)) {
+				WriteVec2(size, {circle.Radius, Real{0}});
+				*type = static_cast<char>(ShapeType::Circle);
+			} else {
+				WriteVec2(size, std::get<AABB>(particle.GetShape()).GetSize());
+				*type = static_cast<char>(ShapeType::Rectangle);
+			}
+		}
+
+		[[nodiscard]] bool IsShapeType(const char type)
+		{
+			using namespace LevelFormat;
+			return static_cast<ShapeType>(type) == ShapeType::Circle || static_cast<ShapeType>(type) == ShapeType::Rectangle;
+		}
+
+		/// The type must have been validated with IsShapeType.
+		void ReadShape(const char* type, const char* size, Particle& particle)
+		{
+			using namespace LevelFormat;
+			if (static_cast<ShapeType>(*type) == ShapeType::Rectangle) particle.SetRectangleSize(ReadVec2(size));
+			else particle.SetCircleRadius(ReadVec2(size).x);
+		}
+
+		[[nodiscard]] uint8_t GetFlags(const Particle& particle)
+		{
+			using namespace LevelFormat;
+			uint8_t flags = 0;
+			if (particle.IsKinematic()) flags |= Kinematic;
+			if (particle.IsAwake()) flags |= Awake;
+			if (particle.IsBullet()) flags |= Bullet;
+			if (particle.IsSensor()) flags |= Sensor;
+			return flags;
+		}
+
+		void SetFlags(const uint8_t flags, Particle& particle)
+		{
+			using namespace LevelFormat;
+			particle.SetKinematic(flags & Kinematic);
+			particle.SetBullet(flags & Bullet);
+			particle.SetSensor(flags & Sensor);
+			// Last, the other setters wake the particle up.
+			particle.SetIsAwake(flags & Awake);
+		}
+
+		void WriteColor(char* destination, const Particle& particle)
+		{
+			const Color color = particle.Data.type() == typeid(Color) ? std::any_cast<Color>(particle.Data) : Color{255,255,255,255};
+			destination[0] = static_cast<char>(color.r);
+			destination[1] = static_cast<char>(color.g);
+			destination[2] = static_cast<char>(color.b);
+			destination[3] = static_cast<char>(color.a);
+		}
+
+		void ReadColor(const char* source, Particle& particle)
+		{
+			const auto* color = reinterpret_cast<const unsigned char*>(source);
+			particle.Data = Color{color[0], color[1], color[2], color[3]};
+		}
+
+		/// The changes a delta can hold, a created particle is written whole.
+		constexpr ParticleChange::Mask DeltaChanges = ParticleChange::Position | ParticleChange::Velocity | ParticleChange::Accelerations
+			| ParticleChange::Material | ParticleChange::State | ParticleChange::Shape | ParticleChange::Created;
+
+		[[nodiscard]] uint64_t GetChangeRecordSize(const ParticleChange::Mask mask)
+		{
+			using namespace LevelFormat;
+			uint64_t size = ChangeField::Fields;
+			if (mask & ParticleChange::Position) size += ChangeField::PositionSize;
+			if (mask & ParticleChange::Velocity) size += ChangeField::VelocitySize;
+			if (mask & ParticleChange::Accelerations) size += ChangeField::AccelerationsSize;
+			if (mask & ParticleChange::Material) size += ChangeField::MaterialSize;
+			if (mask & ParticleChange::State) size += ChangeField::StateSize;
+			if (mask & ParticleChange::Shape) size += ChangeField::ShapeSize;
+			if (mask & ParticleChange::Created) size += ChangeField::ColorSize;
+			return size;
+		}
+
+		void EncodeChange(char* record, const Particle& particle, const World::ID id, const ParticleChange::Mask mask)
+		{
+			using namespace LevelFormat;
+			WriteLittleEndian<uint64_t>(record + ChangeField::Id, id);
+			record[ChangeField::Mask] = static_cast<char>(mask);
+			char* field = record + ChangeField::Fields;
+			if (mask & ParticleChange::Position) {
+				WriteVec2(field, particle.GetPosition());
+				field += ChangeField::PositionSize;
+			}
+			if (mask & ParticleChange::Velocity) {
+				WriteVec2(field, particle.GetVelocity());
+				field += ChangeField::VelocitySize;
+			}
+			if (mask & ParticleChange::Accelerations) {
+				WriteVec2(field, particle.GetConstantAccelerations());
+				field += ChangeField::AccelerationsSize;
+			}
+			if (mask & ParticleChange::Material) {
+				WriteReal(field, particle.GetRebound());
+				WriteReal(field + 8, particle.GetDrag());
+				field += ChangeField::MaterialSize;
+			}
+			if (mask & ParticleChange::State) {
+				*field = static_cast<char>(GetFlags(particle));
+				field += ChangeField::StateSize;
+			}
+			if (mask & ParticleChange::Shape) {
+				WriteShape(field, field + 1, particle);
+				field += ChangeField::ShapeSize;
+			}
+			if (mask & ParticleChange::Created) WriteColor(field, particle);
+		}
+
+		/// Apply the fields of a validated change record to the particle.
+		void DecodeChange(const char* record, const ParticleChange::Mask mask, Particle& particle)
+		{
+			using namespace LevelFormat;
+			const char* field = record + ChangeField::Fields;
+			const char* position = nullptr;
+			const char* state = nullptr;
+			if (mask & ParticleChange::Position) {
+				position = field;
+				field += ChangeField::PositionSize;
+			}
+			if (mask & ParticleChange::Velocity) {
+				particle.SetVelocity(ReadVec2(field));
+				field += ChangeField::VelocitySize;
+			}
+			if (mask & ParticleChange::Accelerations) {
+				particle.SetConstantAcceleration(ReadVec2(field));
+				field += ChangeField::AccelerationsSize;
+			}
+			if (mask & ParticleChange::Material) {
+				particle.SetRebound(ReadReal(field));
+				particle.SetDrag(ReadReal(field + 8));
+				field += ChangeField::MaterialSize;
+			}
+			if (mask & ParticleChange::State) {
+				state = field;
+				field += ChangeField::StateSize;
+			}
+			if (mask & ParticleChange::Shape) {
+				ReadShape(field, field + 1, particle);
+				field += ChangeField::ShapeSize;
+			}
+			if (mask & ParticleChange::Created) ReadColor(field, particle);
+
+			// After the shape which keeps the old position, and the flags after every setter waking the particle up.
+			if (position) particle.SetPosition(ReadVec2(position));
+			if (state) SetFlags(static_cast<uint8_t>(*state), particle);
+		}
+
+		void EncodeParticle(char* record, const Particle& particle, const World::ID id)
+		{
+			using namespace LevelFormat;
+			WriteLittleEndian<uint64_t>(record + ParticleField::Id, id);
+			WriteVec2(record + ParticleField::Position, particle.GetPosition());
+			WriteVec2(record + ParticleField::Velocity, particle.GetVelocity());
+			WriteVec2(record + ParticleField::ConstantAccelerations, particle.GetConstantAccelerations());
+			WriteReal(record + ParticleField::Rebound, particle.GetRebound());
+			WriteReal(record + ParticleField::Drag, particle.GetDrag());
+
+			WriteShape(record + ParticleField::ShapeType, record + ParticleField::ShapeSize, particle);
+			record[ParticleField::Flags] = static_cast<char>(GetFlags(particle));
+			WriteColor(record + ParticleField::Color, particle);
+		}
+
+		[[nodiscard]] World::ID DecodeParticle(const char* record, Particle& particle)
+		{
+			using namespace LevelFormat;
+			particle.SetPosition(ReadVec2(record + ParticleField::Position));
+			particle.SetVelocity(ReadVec2(record + ParticleField::Velocity));
+			particle.AddConstantAcceleration(ReadVec2(record + ParticleField::ConstantAccelerations));
+			particle.SetRebound(ReadReal(record + ParticleField::Rebound));
+			particle.SetDrag(ReadReal(record + ParticleField::Drag));
+
+			ReadShape(record + ParticleField::ShapeType, record + ParticleField::ShapeSize, particle);
+			SetFlags(static_cast<uint8_t>(record[ParticleField::Flags]), particle);
+			ReadColor(record + ParticleField::Color, particle);
+			return ReadLittleEndian<uint64_t>(record + ParticleField::Id);
+		}
+
+		[[nodiscard]] AABB GetShapeBounds(const Particle::Shape& shape)
+		{
+			if (const Circle* circle = std::get_if<Circle>(&shape)) return AABB::FromCenterHalfSize(circle->Position, Vec2{circle->Radius});
+			return std::get<AABB>(shape);
+		}
+
+		void WriteHeader(char* data, const std::array<char, 4>& magic, const uint16_t sectionCount, const uint64_t fileSize)
+		{
+			std::memcpy(data, magic.data(), magic.size());
+			WriteLittleEndian<uint16_t>(data + 4, LevelFormat::Version);
+			WriteLittleEndian<uint16_t>(data + 6, sectionCount);
+			WriteLittleEndian<uint64_t>(data + 8, fileSize);
+		}
+
+		void WriteSectionEntry(char* entry, const LevelFormat::Section type, const uint64_t recordSize, const uint64_t recordCount, const uint64_t offset)
+		{
+			WriteLittleEndian<uint32_t>(entry, static_cast<uint32_t>(type));
+			WriteLittleEndian<uint32_t>(entry + 4, static_cast<uint32_t>(recordSize));
+			WriteLittleEndian<uint64_t>(entry + 8, recordCount);
+			WriteLittleEndian<uint64_t>(entry + 16, offset);
+		}
+
+		[[nodiscard]] int32_t GetTileCoordinate(const Real position, const Real tileSize)
+		{
+			// Clamped, a coordinate out of the range of int32 can't be cast.
+			const double coordinate = std::floor(static_cast<double>(position) / static_cast<double>(tileSize));
+			return static_cast<int32_t>(std::clamp(coordinate, static_cast<double>(INT32_MIN), static_cast<double>(INT32_MAX)));
+		}
+
+	}
+
+	std::vector<char> WorldSerializer::ToBinary(const World& world)
 	{
-		Particle particle;
-		particle.SetPosition(serialization.position);
-		particle.SetVelocity(serialization.velocity);
-		particle.AddConstantAcceleration(serialization.constantAccelerations);
-		particle.SetRebound(serialization.rebound);
-		particle.SetDrag(serialization.drag);
-		switch (serialization.shapeType) {
-			case CIRCLE:
-				particle.SetCircleRadius(serialization.circle.Radius);
-				break;
-			case RECTANGLE:
-				particle.SetRectangleSize(serialization.rectangle.GetSize());
-				break;
-		}
-		particle.SetKinematic(serialization.isKinematic);
-		particle.SetIsAwake(serialization.isAwake);
-		particle.Data = serialization.color;
-		return {particle, serialization.id};
+		return Encode(world, 0);
 	}
 
-	SerializedParticle SerializedParticle::ToSerializedParticle(const FYC::Particle& particle, World::ID id)
+	std::vector<char> WorldSerializer::ToChunkedBinary(const World& world, const Real tileSize)
 	{
-		SerializedParticle serialization;
-		serialization.id = id;
-		serialization.position = particle.GetPosition();
-		serialization.velocity = particle.GetVelocity();
-		serialization.constantAccelerations = particle.GetConstantAccelerations();
-		serialization.rebound = particle.GetRebound();
-		serialization.drag = particle.GetDrag();
-		serialization.isKinematic = particle.IsKinematic();
-		serialization.isAwake = particle.IsAwake();
-		if (particle.HasShape<Circle>(serialization.circle)) serialization.shapeType = CIRCLE;
-		if (particle.HasShape<AABB>(serialization.rectangle)) serialization.shapeType = RECTANGLE;
-		else serialization.shapeType = CIRCLE;
-		serialization.color = particle.Data.type() == typeid(Color) ? std::any_cast<Color>(particle.Data) : Color{255,255,255,255};
-		return serialization;
+		return Encode(world, tileSize);
 	}
 
-	static_assert(sizeof(char) == 1);
-	std::vector<char> WorldSerializer::ToBinary(World world)
+	std::vector<char> WorldSerializer::Encode(const World& world, const Real tileSize)
 	{
-		std::vector<char> rawBuffer(world.count() * sizeof(SerializedParticle) + sizeof(SerializedBounds));
+		using namespace LevelFormat;
+		struct Entry {
+			int32_t X;
+			int32_t Y;
+			World::ID Id;
+			const Particle* Value;
+		};
+
+		const bool isChunked = tileSize > 0;
+		std::vector<Entry> entries;
+		entries.reserve(world.count());
+		world.ForEachParticle([&entries, isChunked, tileSize](const World::ID id, const Particle& particle) {
+			const Vec2 position = particle.GetPosition();
+			if (isChunked) entries.push_back({GetTileCoordinate(position.x, tileSize), GetTileCoordinate(position.y, tileSize), id, &particle});
+			else entries.push_back({0, 0, id, &particle});
+		});
 
-		SerializedBounds* bounds = reinterpret_cast<SerializedBounds*>(rawBuffer.data());
-		bounds->hasBounds = false;
-		if (AABB* b = std::get_if<AABB>(&world.Bounds)) {
-			bounds->hasBounds = true;
-			bounds->bounds = *b;
+		// The particles of a tile are contiguous, the ID breaks the ties so the file doesn't depend on the hash map order.
+		std::vector<LevelTile> tiles;
+		if (isChunked) {
+			std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+				return std::tie(a.Y, a.X, a.Id) < std::tie(b.Y, b.X, b.Id);
+			});
+			for (uint64_t i = 0; i < entries.size(); ++i) {
+				const Entry& entry = entries[i];
+				const AABB bounds = GetShapeBounds(entry.Value->GetShape());
+				if (tiles.empty() || tiles.back().X != entry.X || tiles.back().Y != entry.Y) {
+					tiles.push_back({entry.X, entry.Y, i, 0, bounds});
+				}
+				LevelTile& tile = tiles.back();
+				++tile.ParticleCount;
+				tile.Bounds.Min = {std::min(tile.Bounds.Min.x, bounds.Min.x), std::min(tile.Bounds.Min.y, bounds.Min.y)};
+				tile.Bounds.Max = {std::max(tile.Bounds.Max.x, bounds.Max.x), std::max(tile.Bounds.Max.y, bounds.Max.y)};
+			}
 		}
 
-		SerializedParticle* buffer = reinterpret_cast<SerializedParticle*>(rawBuffer.data() + sizeof(SerializedBounds));
-		uint64_t index{0};
-		for (auto it = world.begin(); it != world.end(); ++it) {
-			buffer[index++] = SerializedParticle::ToSerializedParticle(*it, it.GetID());
+		const bool hasBounds = std::holds_alternative<AABB>(world.Bounds);
+		const auto sectionCount = static_cast<uint16_t>(1 + (hasBounds ? 1 : 0) + (isChunked ? 2 : 0));
+
+		const uint64_t boundsOffset = HeaderSize + sectionCount * SectionEntrySize;
+		const uint64_t tilingOffset = boundsOffset + (hasBounds ? BoundsRecordSize : 0);
+		const uint64_t tilesOffset = tilingOffset + (isChunked ? TilingRecordSize : 0);
+		const uint64_t particlesOffset = tilesOffset + tiles.size() * TileField::RecordSize;
+		const uint64_t fileSize = particlesOffset + entries.size() * ParticleField::RecordSize;
+
+		// Zero initialised, the reserved bytes of the records are written as zero.
+		std::vector<char> binary(fileSize, 0);
+		char* data = binary.data();
+
+		WriteHeader(data, Magic, sectionCount, fileSize);
+
+		char* entry = data + HeaderSize;
+		const auto writeEntry = [&entry](const Section type, const uint64_t recordSize, const uint64_t recordCount, const uint64_t offset) {
+			WriteSectionEntry(entry, type, recordSize, recordCount, offset);
+			entry += SectionEntrySize;
+		};
+
+		if (hasBounds) {
+			writeEntry(Section::Bounds, BoundsRecordSize, 1, boundsOffset);
+			const AABB& bounds = std::get<AABB>(world.Bounds);
+			WriteVec2(data + boundsOffset, bounds.Min);
+			WriteVec2(data + boundsOffset + 16, bounds.Max);
+		}
+
+		if (isChunked) {
+			writeEntry(Section::Tiling, TilingRecordSize, 1, tilingOffset);
+			WriteReal(data + tilingOffset, tileSize);
+
+			writeEntry(Section::Tiles, TileField::RecordSize, tiles.size(), tilesOffset);
+			char* record = data + tilesOffset;
+			for (const LevelTile& tile : tiles) {
+				WriteLittleEndian<uint32_t>(record + TileField::X, static_cast<uint32_t>(tile.X));
+				WriteLittleEndian<uint32_t>(record + TileField::Y, static_cast<uint32_t>(tile.Y));
+				WriteLittleEndian<uint64_t>(record + TileField::FirstParticle, tile.FirstParticle);
+				WriteLittleEndian<uint64_t>(record + TileField::ParticleCount, tile.ParticleCount);
+				WriteVec2(record + TileField::Bounds, tile.Bounds.Min);
+				WriteVec2(record + TileField::Bounds + 16, tile.Bounds.Max);
+				record += TileField::RecordSize;
+			}
+		}
+
+		writeEntry(Section::Particles, ParticleField::RecordSize, entries.size(), particlesOffset);
+		char* record = data + particlesOffset;
+		for (const Entry& particle : entries) {
+			EncodeParticle(record, *particle.Value, particle.Id);
+			record += ParticleField::RecordSize;
+		}
+
+		return binary;
+	}
+
+	bool WorldSerializer::FromBinary(const std::span<const char> binary, World& world)
+	{
+		if (binary.size() < LevelFormat::HeaderSize || std::memcmp(binary.data(), LevelFormat::Magic.data(), LevelFormat::Magic.size()) != 0) {
+			return FromLegacyBinary(binary, world);
+		}
+
+		LevelView level;
+		if (!ReadLevel(binary, level)) return false;
+
+		World decoded(level.ParticleCount, world.GetMemoryResource());
+		if (level.Bounds) decoded.Bounds = AABB::FromMinMax(ReadVec2(level.Bounds), ReadVec2(level.Bounds + 16));
+
+		// Fast path, each record is decoded straight into the particle stored by the world.
+		for (uint64_t i = 0; i < level.ParticleCount; ++i) {
+			Particle particle;
+			const World::ID id = DecodeParticle(level.Particles + i * level.ParticleRecordSize, particle);
+			decoded.SetParticle(std::move(particle), id);
+		}
+
+		world = std::move(decoded);
+		return true;
+	}
+
+	bool WorldSerializer::ReadLevel(const std::span<const char> binary, LevelView& level)
+	{
+		using namespace LevelFormat;
+		if (binary.size() < HeaderSize || std::memcmp(binary.data(), Magic.data(), Magic.size()) != 0) return false;
+
+		const char* data = binary.data();
+		const auto version = ReadLittleEndian<uint16_t>(data + 4);
+		const auto sectionCount = ReadLittleEndian<uint16_t>(data + 6);
+		const auto fileSize = ReadLittleEndian<uint64_t>(data + 8);
+		if (version == 0 || version > Version) return false;
+		if (fileSize != binary.size() || HeaderSize + sectionCount * SectionEntrySize > fileSize) return false;
+
+		// Validate the whole table before touching anything, the decoding never reads out of the file.
+		LevelView view;
+		for (uint16_t i = 0; i < sectionCount; ++i) {
+			const char* entry = data + HeaderSize + i * SectionEntrySize;
+			const auto type = static_cast<Section>(ReadLittleEndian<uint32_t>(entry));
+			const uint64_t recordSize = ReadLittleEndian<uint32_t>(entry + 4);
+			const auto recordCount = ReadLittleEndian<uint64_t>(entry + 8);
+			const auto offset = ReadLittleEndian<uint64_t>(entry + 16);
+			if (offset > fileSize || (recordSize != 0 && recordCount > (fileSize - offset) / recordSize)) return false;
+
+			switch (type) {
+				case Section::Bounds:
+					if (recordCount != 1 || recordSize < BoundsRecordSize) return false;
+					view.Bounds = data + offset;
+					break;
+				case Section::Particles:
+					if (recordSize < ParticleField::RecordSize) return false;
+					view.Particles = data + offset;
+					view.ParticleRecordSize = recordSize;
+					view.ParticleCount = recordCount;
+					break;
+				case Section::Tiling:
+					if (recordCount != 1 || recordSize < TilingRecordSize || !std::isfinite(ReadDouble(data + offset))) return false;
+					view.TileSize = ReadReal(data + offset);
+					break;
+				case Section::Tiles:
+					if (recordSize < TileField::RecordSize) return false;
+					view.Tiles = data + offset;
+					view.TileRecordSize = recordSize;
+					view.TileCount = recordCount;
+					break;
+				default:
+					// Written by a newer version, skipped.
+					break;
+			}
+		}
+
+		// NaN fails the comparison too, and a size too small for the Real of the build is read as zero.
+		if (view.Tiles && !(view.TileSize > 0)) return false;
+		for (uint64_t i = 0; i < view.TileCount; ++i) {
+			const LevelTile tile = ReadTile(view, i);
+			if (tile.FirstParticle > view.ParticleCount || tile.ParticleCount > view.ParticleCount - tile.FirstParticle) return false;
+		}
+		for (uint64_t i = 0; i < view.ParticleCount; ++i) {
+			if (!IsShapeType(view.Particles[i * view.ParticleRecordSize + ParticleField::ShapeType])) return false;
+		}
+
+		level = view;
+		return true;
+	}
+
+	LevelTile WorldSerializer::ReadTile(const LevelView& level, const uint64_t index)
+	{
+		using namespace LevelFormat;
+		const char* record = level.Tiles + index * level.TileRecordSize;
+		return {
+			static_cast<int32_t>(ReadLittleEndian<uint32_t>(record + TileField::X)),
+			static_cast<int32_t>(ReadLittleEndian<uint32_t>(record + TileField::Y)),
+			ReadLittleEndian<uint64_t>(record + TileField::FirstParticle),
+			ReadLittleEndian<uint64_t>(record + TileField::ParticleCount),
+			AABB::FromMinMax(ReadVec2(record + TileField::Bounds), ReadVec2(record + TileField::Bounds + 16)),
+		};
+	}
+
+	World::ID WorldSerializer::ReadParticle(const LevelView& level, const uint64_t index, Particle& particle)
+	{
+		return DecodeParticle(level.Particles + index * level.ParticleRecordSize, particle);
+	}
+
+	std::vector<char> WorldSerializer::ToDelta(const World& world)
+	{
+		using namespace LevelFormat;
+		struct Entry {
+			World::ID Id;
+			ParticleChange::Mask Mask;
+			const Particle* Value;
+		};
+
+		std::vector<Entry> entries;
+		uint64_t changesSize = 0;
+		world.ForEachChangedParticle([&entries, &changesSize](const World::ID id, const Particle& particle) {
+			const ParticleChange::Mask changes = particle.GetChanges();
+			const ParticleChange::Mask mask = (changes & ParticleChange::Created) ? DeltaChanges : changes & DeltaChanges;
+			if (mask == ParticleChange::None) return;
+			entries.push_back({id, mask, &particle});
+			changesSize += GetChangeRecordSize(mask);
+		});
+		// Sorted so the delta doesn't depend on the hash map order.
+		std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.Id < b.Id; });
+
+		const std::span<const World::ID> removed = world.GetRemovedParticles();
+		constexpr uint16_t sectionCount = 2;
+		const uint64_t removedOffset = HeaderSize + sectionCount * SectionEntrySize;
+		const uint64_t changesOffset = removedOffset + removed.size() * 8;
+		const uint64_t fileSize = changesOffset + changesSize;
+
+		std::vector<char> binary(fileSize);
+		char* data = binary.data();
+		WriteHeader(data, DeltaMagic, sectionCount, fileSize);
+		WriteSectionEntry(data + HeaderSize, Section::Removed, 8, removed.size(), removedOffset);
+		WriteSectionEntry(data + HeaderSize + SectionEntrySize, Section::Changes, 1, changesSize, changesOffset);
+
+		for (uint64_t i = 0; i < removed.size(); ++i) WriteLittleEndian<uint64_t>(data + removedOffset + i * 8, removed[i]);
+		char* record = data + changesOffset;
+		for (const Entry& entry : entries) {
+			EncodeChange(record, *entry.Value, entry.Id, entry.Mask);
+			record += GetChangeRecordSize(entry.Mask);
 		}
 
-		return std::move(rawBuffer);
+		return binary;
 	}
 
-	World WorldSerializer::FromBinary(const std::vector<char> &binary) {
-		World world;
-		const uint64_t count = (binary.size() - sizeof(SerializedBounds)) / sizeof(SerializedParticle);
+	bool WorldSerializer::ApplyDelta(const std::span<const char> binary, World& world)
+	{
+		using namespace LevelFormat;
+		if (binary.size() < HeaderSize || std::memcmp(binary.data(), DeltaMagic.data(), DeltaMagic.size()) != 0) return false;
+
+		const char* data = binary.data();
+		const auto version = ReadLittleEndian<uint16_t>(data + 4);
+		const auto sectionCount = ReadLittleEndian<uint16_t>(data + 6);
+		const auto fileSize = ReadLittleEndian<uint64_t>(data + 8);
+		if (version == 0 || version > Version) return false;
+		if (fileSize != binary.size() || HeaderSize + sectionCount * SectionEntrySize > fileSize) return false;
 
-		const SerializedBounds* serializedBounds = reinterpret_cast<const SerializedBounds*>(binary.data());
-		if (serializedBounds->hasBounds) {
-			world.Bounds = serializedBounds->bounds;
+		std::span<const char> removed;
+		uint64_t removedRecordSize = 8;
+		std::span<const char> changes;
+		for (uint16_t i = 0; i < sectionCount; ++i) {
+			const char* entry = data + HeaderSize + i * SectionEntrySize;
+			const auto type = static_cast<Section>(ReadLittleEndian<uint32_t>(entry));
+			const uint64_t recordSize = ReadLittleEndian<uint32_t>(entry + 4);
+			const auto recordCount = ReadLittleEndian<uint64_t>(entry + 8);
+			const auto offset = ReadLittleEndian<uint64_t>(entry + 16);
+			if (offset > fileSize || (recordSize != 0 && recordCount > (fileSize - offset) / recordSize)) return false;
+
+			if (type == Section::Removed) {
+				if (recordSize < 8) return false;
+				removed = binary.subspan(offset, recordSize * recordCount);
+				removedRecordSize = recordSize;
+			} else if (type == Section::Changes) {
+				if (recordSize != 1) return false;
+				changes = binary.subspan(offset, recordCount);
+			}
+		}
+
+		// The change records are walked once to validate them, so a bad one doesn't leave the world half updated.
+		for (uint64_t offset = 0; offset < changes.size();) {
+			if (changes.size() - offset < ChangeField::Fields) return false;
+			const auto mask = static_cast<ParticleChange::Mask>(changes[offset + ChangeField::Mask]);
+			if ((mask & ~DeltaChanges) != 0 || ((mask & ParticleChange::Created) && mask != DeltaChanges)) return false;
+			const uint64_t size = GetChangeRecordSize(mask);
+			if (changes.size() - offset < size) return false;
+			// The shape follows the fields of the lower bits.
+			const uint64_t shapeOffset = GetChangeRecordSize(static_cast<ParticleChange::Mask>(mask & (ParticleChange::Shape - 1)));
+			if ((mask & ParticleChange::Shape) && !IsShapeType(changes[offset + shapeOffset])) return false;
+			offset += size;
+		}
+
+		// Removed first, a particle removed then created again since the baseline has both.
+		for (uint64_t i = 0; i < removed.size(); i += removedRecordSize) {
+			world.RemoveParticle(ReadLittleEndian<uint64_t>(removed.data() + i));
+		}
+
+		for (uint64_t offset = 0; offset < changes.size();) {
+			const char* record = changes.data() + offset;
+			const auto id = ReadLittleEndian<uint64_t>(record + ChangeField::Id);
+			const auto mask = static_cast<ParticleChange::Mask>(record[ChangeField::Mask]);
+			offset += GetChangeRecordSize(mask);
+
+			if (mask & ParticleChange::Created) {
+				Particle particle;
+				DecodeChange(record, mask, particle);
+				world.SetParticle(std::move(particle), id);
+			} else if (auto it = world.find(id); it != world.end()) {
+				DecodeChange(record, mask, *it);
+			}
 		}
 
-		const SerializedParticle* buffer = reinterpret_cast<const SerializedParticle*>(binary.data() + sizeof(SerializedBounds));
-		uint64_t cursor{0};
-		for (int i = 0; i < count; ++i) {
-			auto&& [particle, id] = SerializedParticle::ToParticle(buffer[i]);
-			world.SetParticle(std::move(particle), id);
+		return true;
+	}
+
+	bool WorldSerializer::FromLegacyBinary(const std::span<const char> binary, World& world)
+	{
+		if (binary.size() < sizeof(LegacyBounds) || (binary.size() - sizeof(LegacyBounds)) % sizeof(LegacyParticle) != 0) return false;
+		const uint64_t count = (binary.size() - sizeof(LegacyBounds)) / sizeof(LegacyParticle);
+
+		World decoded(count, world.GetMemoryResource());
+		LegacyBounds bounds;
+		std::memcpy(static_cast<void*>(&bounds), binary.data(), sizeof(LegacyBounds));
+		if (bounds.hasBounds) decoded.Bounds = bounds.bounds;
+
+		for (uint64_t i = 0; i < count; ++i) {
+			LegacyParticle serialization;
+			std::memcpy(static_cast<void*>(&serialization), binary.data() + sizeof(LegacyBounds) + i * sizeof(LegacyParticle), sizeof(LegacyParticle));
+			if (serialization.shapeType != LegacyParticle::CIRCLE && serialization.shapeType != LegacyParticle::RECTANGLE) return false;
+
+			Particle particle;
+			particle.SetPosition(serialization.position);
+			particle.SetVelocity(serialization.velocity);
+			particle.AddConstantAcceleration(serialization.constantAccelerations);
+			particle.SetRebound(serialization.rebound);
+			particle.SetDrag(serialization.drag);
+			if (serialization.shapeType == LegacyParticle::RECTANGLE) particle.SetRectangleSize(serialization.rectangle.GetSize());
+			else particle.SetCircleRadius(serialization.circle.Radius);
+			particle.SetKinematic(serialization.isKinematic);
+			particle.SetIsAwake(serialization.isAwake);
+			particle.Data = serialization.color;
+			decoded.SetParticle(std::move(particle), serialization.id);
 		}
 
-		return std::move(world);
+		world = std::move(decoded);
+		return true;
 	}
 }
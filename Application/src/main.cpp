@@ -3,13 +3,15 @@
 int main(int argc, const char** argv)
 {
 	bool isEditing = false;
+	bool usePhysicsThread = false;
 	for (int i = 0; i < argc; ++i) {
 		std::string_view arg = argv[i];
 		if (arg.find("--edit") != std::string_view::npos) isEditing = true;
 		if (arg.find("-e") != std::string_view::npos) isEditing = true;
+		if (arg == "--physics-thread") usePhysicsThread = true;
 	}
 
-	Application* application = new Application(1600, 900, "Application", isEditing);
+	Application* application = new Application(1600, 900, "Application", isEditing, usePhysicsThread);
 
 	application->Run();
 
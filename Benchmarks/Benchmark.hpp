@@ -0,0 +1,25 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+namespace FYC::Benchmarks {
+
+	using Clock = std::chrono::steady_clock;
+
+	[[nodiscard]] inline double ToMicroseconds(const Clock::duration duration)
+	{
+		return std::chrono::duration<double, std::micro>(duration).count();
+	}
+
+	/// Average wall-clock time of a call of the function in microseconds, after a first call to warm up.
+	template<typename Function>
+	[[nodiscard]] double MeasureMicroseconds(const uint32_t repetitions, Function&& function)
+	{
+		function();
+		const Clock::time_point start = Clock::now();
+		for (uint32_t i = 0; i < repetitions; ++i) function();
+		return ToMicroseconds(Clock::now() - start) / repetitions;
+	}
+
+} // FYC::Benchmarks
@@ -0,0 +1,67 @@
+#include "Physics/World.hpp"
+#include "Benchmark.hpp"
+
+using namespace FYC;
+using namespace FYC::Benchmarks;
+
+namespace {
+
+	struct CountingListener : World::CollisionListener {
+		uint64_t Records = 0;
+		Real Interpenetration{0};
+
+		void OnCollisions(World&, const std::span<const World::CollisionRecord> records) override
+		{
+			Records += records.size();
+			for (const World::CollisionRecord& record : records) Interpenetration += record.Contact.Interpenetration;
+		}
+	};
+
+}
+
+// Cost of sending the contacts of 10k listened particles to their listener, against asking every particle for them.
+int main()
+{
+	constexpr uint32_t side = 100;
+	constexpr uint32_t steps = 20;
+
+	World world(side * side);
+	std::vector<World::ID> ids;
+	for (uint32_t x = 0; x < side; ++x) {
+		for (uint32_t y = 0; y < side; ++y) {
+			ids.push_back(world.AddParticle(Particle::CreateCircle({static_cast<Real>(x) * Real{0.9}, static_cast<Real>(y) * Real{0.9}}, Real{0.5})).GetID());
+		}
+	}
+	CountingListener listener;
+	for (const World::ID id : ids) world.Listen(id, listener);
+
+	// Only the stage calling the listeners is timed.
+	StepGraph& graph = world.GetStepGraph();
+	StepStage callbacks = *std::find_if(graph.GetStages().begin(), graph.GetStages().end(), [](const StepStage& stage) { return stage.Name == "Callbacks"; });
+	Clock::duration dispatchTime{};
+	callbacks.Run = [run = callbacks.Run, &dispatchTime](World& stepped, const Real stepTime) {
+		const Clock::time_point start = Clock::now();
+		run(stepped, stepTime);
+		dispatchTime += Clock::now() - start;
+	};
+	graph.RemoveStage("Callbacks");
+	graph.AddStage(std::move(callbacks), "ContactEvents");
+
+	// Two substeps, the contacts are found with the broadphase.
+	for (uint32_t step = 0; step < steps; ++step) world.Step(Real{1} / 60, 2);
+	std::printf("Listener: %llu contacts per step, %.1f us per step\n",
+		static_cast<unsigned long long>(listener.Records / steps), ToMicroseconds(dispatchTime) / steps);
+
+	uint64_t records = 0;
+	Real interpenetration{0};
+	const double perParticle = MeasureMicroseconds(steps, [&world, &ids, &records, &interpenetration]() {
+		for (const World::ID id : ids) {
+			world.ForEachCollision(id, [&records, &interpenetration](World::ID, const Collision& collision) {
+				++records;
+				interpenetration += collision.Interpenetration;
+			});
+		}
+	});
+	std::printf("ForEachCollision on every particle: %llu contacts, %.1f us\n", static_cast<unsigned long long>(records / (steps + 1)), perParticle);
+	return 0;
+}
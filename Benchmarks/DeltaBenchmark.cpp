@@ -0,0 +1,45 @@
+#include "WorldSerializer.hpp"
+#include "Benchmark.hpp"
+
+using namespace FYC;
+using namespace FYC::Application;
+using namespace FYC::Benchmarks;
+
+// Size of the deltas of a 10k particle world settling on a floor, against sending the whole level every step.
+int main()
+{
+	constexpr uint32_t side = 100;
+	constexpr uint32_t steps = 300;
+
+	World world(side * side + 1);
+	world.AddParticle(Particle::CreateRectangle({static_cast<Real>(side), -2}, {static_cast<Real>(side) * 4, 2}));
+	for (uint32_t x = 0; x < side; ++x) {
+		for (uint32_t y = 0; y < side; ++y) {
+			Particle particle = Particle::CreateCircle({static_cast<Real>(x) * 2, static_cast<Real>(y) * 2}, Real{0.9});
+			particle.SetKinematic(true);
+			particle.AddConstantAcceleration({0, Real{-9.8}});
+			particle.Data = Color{255, 255, 255, 255};
+			world.AddParticle(std::move(particle));
+		}
+	}
+	const uint64_t levelSize = WorldSerializer::ToBinary(world).size();
+	world.ClearChanges();
+
+	uint64_t deltaSize = 0;
+	uint64_t changedParticles = 0;
+	Clock::duration encodeTime{};
+	for (uint32_t step = 0; step < steps; ++step) {
+		world.Step(Real{1} / 60, 4);
+		world.ForEachChangedParticle([&changedParticles](World::ID, const Particle&) { ++changedParticles; });
+		const Clock::time_point start = Clock::now();
+		deltaSize += WorldSerializer::ToDelta(world).size();
+		encodeTime += Clock::now() - start;
+		world.ClearChanges();
+	}
+
+	std::printf("Level: %llu bytes\n", static_cast<unsigned long long>(levelSize));
+	std::printf("Delta: %llu bytes per step for %llu changed particles, %.1f bytes per particle, encoded in %.1f us\n",
+		static_cast<unsigned long long>(deltaSize / steps), static_cast<unsigned long long>(changedParticles / steps),
+		changedParticles == 0 ? 0.0 : static_cast<double>(deltaSize) / static_cast<double>(changedParticles), ToMicroseconds(encodeTime) / steps);
+	return 0;
+}
@@ -0,0 +1,80 @@
+#include "Physics/JobSystem.hpp"
+#include "Physics/World.hpp"
+#include "Benchmark.hpp"
+
+using namespace FYC;
+using namespace FYC::Benchmarks;
+
+namespace {
+
+	constexpr uint32_t ThreadCounts[] = {1, 2, 4, 8, 16};
+
+	/// A loop whose iterations cost more and more, so the threads given the end have to be helped by the others.
+	double RunLoop(const uint32_t threads, double& singleThreaded)
+	{
+		constexpr uint32_t count = 1u << 16;
+		constexpr uint32_t grainSize = 256;
+		JobSystem jobs(threads);
+		std::vector<double> chunkSums(JobSystem::GetChunkCount(count, grainSize));
+		const double microseconds = MeasureMicroseconds(20, [&jobs, &chunkSums]() {
+			jobs.ParallelFor(count, grainSize, [&chunkSums](const uint32_t begin, const uint32_t end) {
+				double sum = 0;
+				for (uint32_t i = begin; i < end; ++i) {
+					for (uint32_t j = 0; j < i / 1024 + 1; ++j) sum += std::sqrt(static_cast<double>(i + j));
+				}
+				chunkSums[begin / grainSize] = sum;
+			});
+		});
+		double sum = 0;
+		for (const double chunkSum : chunkSums) sum += chunkSum;
+		if (threads == 1) singleThreaded = microseconds;
+		std::printf("ParallelFor, %2u threads: %.0f us, %.2fx", threads, microseconds, singleThreaded / microseconds);
+		return sum;
+	}
+
+	/// Rain of circles on a floor, every phase of the step has thousands of particles or pairs to go through.
+	double RunSteps(const uint32_t threads, double& singleThreaded)
+	{
+		constexpr int32_t side = 120;
+		constexpr uint32_t steps = 20;
+		World world(static_cast<uint64_t>(side) * side + 1);
+		world.Solver.Type = SolverType::Speculative;
+		world.Solver.ThreadCount = threads;
+		world.AddParticle(Particle::CreateRectangle({static_cast<Real>(side), 2}, {static_cast<Real>(side) * 4, 1}))->SetKinematic(false);
+		for (int32_t row = 0; row < side; ++row) {
+			for (int32_t column = 0; column < side; ++column) {
+				const Vec2 position{static_cast<Real>(column) * 2 + static_cast<Real>(row % 2), -static_cast<Real>(row) * 2};
+				world.AddParticle(Particle::CreateCircle(position, Real{0.9}, {0, 0}, {0, 10}))->SetDrag(Real{0.1});
+			}
+		}
+
+		const Clock::time_point start = Clock::now();
+		for (uint32_t step = 0; step < steps; ++step) world.Step(Real{1} / 60, 2);
+		const double microseconds = ToMicroseconds(Clock::now() - start) / steps;
+
+		double checksum = 0;
+		for (auto it = world.begin(); it != world.end(); ++it) {
+			checksum += static_cast<double>(it->GetPosition().y) * static_cast<double>(it.GetID() % 7 + 1) + static_cast<double>(it->GetPosition().x);
+		}
+		if (threads == 1) singleThreaded = microseconds;
+		std::printf("Step of %llu particles, %2u threads: %.0f us, %.2fx", static_cast<unsigned long long>(world.count()), threads, microseconds, singleThreaded / microseconds);
+		return checksum;
+	}
+
+}
+
+// Scaling of the job system from 1 to 16 threads, on an uneven loop and on whole steps.
+int main()
+{
+	// The results are merged in chunk order, they must not depend on the thread count.
+	for (double (*run)(uint32_t, double&) : {&RunLoop, &RunSteps}) {
+		double singleThreaded = 0;
+		double reference = 0;
+		for (const uint32_t threads : ThreadCounts) {
+			const double result = run(threads, singleThreaded);
+			if (threads == 1) reference = result;
+			std::printf(", %s\n", result == reference ? "same result" : "DIFFERENT result");
+		}
+	}
+	return 0;
+}
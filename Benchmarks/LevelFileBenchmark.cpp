@@ -0,0 +1,62 @@
+#include "MappedFile.hpp"
+#include "WorldSerializer.hpp"
+#include "Benchmark.hpp"
+
+using namespace FYC;
+using namespace FYC::Application;
+using namespace FYC::Benchmarks;
+
+namespace {
+
+	void WriteLevel(const std::filesystem::path& filepath, const uint32_t particleCount)
+	{
+		World world(particleCount);
+		world.Bounds = AABB::FromMinMax({-2000, -2000}, {2000, 2000});
+		for (uint32_t i = 0; i < particleCount; ++i) {
+			const Vec2 position{static_cast<Real>(i % 1000) * 2, static_cast<Real>(i / 1000) * 2};
+			auto it = world.AddParticle(Particle::CreateCircle(position, Real{0.5}));
+			it->SetKinematic(i % 10 == 0);
+			it->Data = Color{255, 255, 255, 255};
+		}
+		const std::vector<char> binary = WorldSerializer::ToBinary(world);
+		std::ofstream file(filepath, std::ios::out | std::ios::binary | std::ios::trunc);
+		file.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+	}
+
+	/// Time from opening the file to the end of the first step, with the way the file gets to the decoder.
+	template<typename Read>
+	void MeasureFirstStep(const char* name, Read&& read)
+	{
+		World world;
+		const Clock::time_point start = Clock::now();
+		const bool loaded = read(world);
+		const Clock::time_point decoded = Clock::now();
+		world.Step(Real{1} / 60, 2);
+		const Clock::time_point stepped = Clock::now();
+		std::printf("%s: %s %llu particles, load %.1f ms, first step %.1f ms, time to first step %.1f ms\n", name, loaded ? "loaded" : "FAILED to load",
+			static_cast<unsigned long long>(world.count()), ToMicroseconds(decoded - start) / 1000, ToMicroseconds(stepped - decoded) / 1000, ToMicroseconds(stepped - start) / 1000);
+	}
+
+}
+
+// Time to first step of a 1M particle level, read in a buffer through a stream as it used to be, then decoded from the mapped file.
+// The level was just written, so both read it from the page cache.
+int main()
+{
+	const std::filesystem::path filepath = std::filesystem::temp_directory_path() / "LevelFileBenchmark.fyc";
+	WriteLevel(filepath, 1'000'000);
+	std::printf("Level of %.1f MB\n", static_cast<double>(std::filesystem::file_size(filepath)) / 1e6);
+
+	MeasureFirstStep("Stream", [&filepath](World& world) {
+		std::ifstream file(filepath, std::ios::binary);
+		const std::vector<char> binary{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+		return WorldSerializer::FromBinary(binary, world);
+	});
+	MeasureFirstStep("Mapped", [&filepath](World& world) {
+		const MappedFile file(filepath);
+		return file && WorldSerializer::FromBinary(file.GetData(), world);
+	});
+
+	std::filesystem::remove(filepath);
+	return 0;
+}
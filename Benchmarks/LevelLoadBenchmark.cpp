@@ -0,0 +1,50 @@
+#include "WorldSerializer.hpp"
+#include "Benchmark.hpp"
+
+using namespace FYC;
+using namespace FYC::Application;
+using namespace FYC::Benchmarks;
+
+namespace {
+
+	World CreateWorld(const uint32_t side)
+	{
+		World world(side * side);
+		for (uint32_t x = 0; x < side; ++x) {
+			for (uint32_t y = 0; y < side; ++y) {
+				const Vec2 position{static_cast<Real>(x) * 3, static_cast<Real>(y) * 3};
+				Particle particle = (x + y) % 2 == 0 ? Particle::CreateCircle(position, 1) : Particle::CreateRectangle(position, {2, 2});
+				particle.Data = Color{static_cast<unsigned char>(x), static_cast<unsigned char>(y), 128, 255};
+				world.AddParticle(std::move(particle));
+			}
+		}
+		return world;
+	}
+
+	void PrintThroughput(const char* name, const std::vector<char>& binary, const double microseconds)
+	{
+		std::printf("%s: %.2f MB in %.1f us, %.0f MB/s\n", name, static_cast<double>(binary.size()) / 1e6, microseconds, static_cast<double>(binary.size()) / microseconds);
+	}
+
+}
+
+// Decoding speed of a 90k particle level already in memory, plain and cut in tiles.
+int main()
+{
+	constexpr uint32_t repetitions = 10;
+
+	World source = CreateWorld(300);
+	const std::vector<char> plain = WorldSerializer::ToBinary(source);
+	const std::vector<char> chunked = WorldSerializer::ToChunkedBinary(source, 64);
+
+	bool loaded = true;
+	PrintThroughput("Plain level", plain, MeasureMicroseconds(repetitions, [&plain, &loaded]() {
+		World world;
+		loaded &= WorldSerializer::FromBinary(plain, world);
+	}));
+	PrintThroughput("Chunked level", chunked, MeasureMicroseconds(repetitions, [&chunked, &loaded]() {
+		World world;
+		loaded &= WorldSerializer::FromBinary(chunked, world);
+	}));
+	return loaded ? 0 : 1;
+}
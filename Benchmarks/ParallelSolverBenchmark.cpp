@@ -0,0 +1,80 @@
+#include "Physics/World.hpp"
+#include "Benchmark.hpp"
+
+using namespace FYC;
+using namespace FYC::Benchmarks;
+
+namespace {
+
+	World CreatePile(const int32_t side, const uint32_t threadCount)
+	{
+		World world(static_cast<uint64_t>(side) * side + 1);
+		world.Solver.Type = SolverType::SequentialImpulse;
+		world.Solver.Tolerance = 0;
+		world.Solver.ThreadCount = threadCount;
+		world.AddParticle(Particle::CreateRectangle({static_cast<Real>(side) / 2, 1}, {static_cast<Real>(side) * 2, 1}))->SetKinematic(false);
+		for (int32_t row = 0; row < side; ++row) {
+			for (int32_t column = 0; column < side; ++column) {
+				const Vec2 position{static_cast<Real>(column) * Real{0.999}, -static_cast<Real>(row) * Real{0.999}};
+				world.AddParticle(Particle::CreateRectangle(position, {1, 1}, {0, 0}, {0, 10}));
+			}
+		}
+		return world;
+	}
+
+	/// Sum of the positions weighted by the IDs, equal between two runs only if every particle ended at the same place.
+	double GetChecksum(World& world)
+	{
+		double checksum = 0;
+		for (auto it = world.begin(); it != world.end(); ++it) {
+			checksum += static_cast<double>(it->GetPosition().y) * static_cast<double>(it.GetID() % 7 + 1) + static_cast<double>(it->GetPosition().x);
+		}
+		return checksum;
+	}
+
+}
+
+// Scaling of the contact solver of a 12k box pile, about 50k contacts a substep, from one thread to every core.
+int main()
+{
+	constexpr int32_t side = 113;
+	constexpr uint32_t steps = 5;
+
+	const uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	double singleThreaded = 0;
+	double reference = 0;
+	for (uint32_t threads = 1; threads <= maxThreads; threads *= 2) {
+		World world = CreatePile(side, threads);
+
+		// Only the stage detecting and solving the contacts is timed.
+		StepGraph& graph = world.GetStepGraph();
+		StepStage solve = *std::find_if(graph.GetStages().begin(), graph.GetStages().end(), [](const StepStage& stage) { return stage.Name == "Solve"; });
+		Clock::duration solveTime{};
+		solve.Run = [run = solve.Run, &solveTime](World& stepped, const Real stepTime) {
+			const Clock::time_point start = Clock::now();
+			run(stepped, stepTime);
+			solveTime += Clock::now() - start;
+		};
+		graph.RemoveStage("Solve");
+		graph.AddStage(std::move(solve), "ClearAccelerations");
+
+		uint64_t contacts = 0;
+		uint64_t batches = 0;
+		for (uint32_t step = 0; step < steps; ++step) {
+			world.Step(Real{1} / 60, 2);
+			contacts += world.GetStepStatistics().ContactCount;
+			batches += world.GetStepStatistics().ContactBatches;
+		}
+
+		const double microseconds = ToMicroseconds(solveTime) / steps;
+		const double checksum = GetChecksum(world);
+		if (threads == 1) {
+			singleThreaded = microseconds;
+			reference = checksum;
+		}
+		std::printf("%2u threads: %llu contacts in %llu batches, %.0f us per step, %.2fx, %s\n", threads,
+			static_cast<unsigned long long>(contacts / steps), static_cast<unsigned long long>(batches / steps), microseconds, singleThreaded / microseconds,
+			checksum == reference ? "same result" : "DIFFERENT result");
+	}
+	return 0;
+}
@@ -0,0 +1,71 @@
+#include "Physics/World.hpp"
+#include "Benchmark.hpp"
+
+using namespace FYC;
+using namespace FYC::Benchmarks;
+
+namespace {
+
+	constexpr uint32_t OperationCount = 1'000'000;
+
+	/// Nanoseconds per operation of the function over a range of values, the sum is kept so the loop isn't optimized away.
+	template<typename T, typename Operation>
+	double MeasureOperation(Operation&& operation)
+	{
+		volatile double sink = 0;
+		const double microseconds = MeasureMicroseconds(5, [&operation, &sink]() {
+			T sum{0};
+			for (uint32_t i = 1; i <= OperationCount; ++i) sum += operation(T(static_cast<int32_t>(i % 1000 + 1)) / T(7));
+			sink = sink + static_cast<double>(sum);
+		});
+		return microseconds * 1000 / OperationCount;
+	}
+
+	template<typename T>
+	void PrintOperations(const char* name, T (*sqrt)(T), T (*sin)(T))
+	{
+		const double multiply = MeasureOperation<T>([](const T value) { return value * value; });
+		const double divide = MeasureOperation<T>([](const T value) { return T(1) / value; });
+		const double squareRoot = MeasureOperation<T>([sqrt](const T value) { return sqrt(value); });
+		const double sine = MeasureOperation<T>([sin](const T value) { return sin(value); });
+		std::printf("%s: multiply %.2f ns, divide %.2f ns, sqrt %.2f ns, sin %.2f ns\n", name, multiply, divide, squareRoot, sine);
+	}
+
+	float SqrtFloat(const float value) { return std::sqrt(value); }
+	float SinFloat(const float value) { return std::sin(value); }
+
+}
+
+// Cost of the fixed-point numbers against floats, alone and for a whole step.
+// The step is measured with the Real of the build, compare a build with FYC_FIXED against one without it.
+int main()
+{
+	PrintOperations<float>("float", &SqrtFloat, &SinFloat);
+	PrintOperations<Fixed>("Fixed", &Fixed::Sqrt, &Fixed::Sin);
+
+	constexpr uint32_t steps = 300;
+	World world;
+	world.Bounds = AABB::FromCenterSize({0, 0}, {200, 100});
+	world.AddParticle(Particle::CreateRectangle({0, 40}, {180, 1}))->SetKinematic(false);
+	for (int32_t row = 0; row < 20; ++row) {
+		for (int32_t column = 0; column < 40; ++column) {
+			const Vec2 position{static_cast<Real>(column) * Real{1.1} - 22 + static_cast<Real>(row % 2) * Real{0.5}, 38 - static_cast<Real>(row) * Real{1.05}};
+			world.AddParticle(Particle::CreateRectangle(position, {1, 1}, {0, 0}, {0, 10}));
+		}
+	}
+	for (int32_t i = 0; i < 100; ++i) {
+		world.AddParticle(Particle::CreateCircle({static_cast<Real>(i - 60), static_cast<Real>(-20 - i % 5)}, Real{0.4}, {3, 0}, {0, 10}))->SetRebound(Real{0.9});
+	}
+
+	const Clock::time_point start = Clock::now();
+	for (uint32_t step = 0; step < steps; ++step) world.Step(Real{1} / 60, 2);
+#if defined(FYC_FIXED)
+	const char* real = "Fixed";
+#elif defined(FYC_DOUBLE)
+	const char* real = "double";
+#else
+	const char* real = "float";
+#endif
+	std::printf("Step of %llu particles with %s: %.1f us\n", static_cast<unsigned long long>(world.count()), real, ToMicroseconds(Clock::now() - start) / steps);
+	return 0;
+}
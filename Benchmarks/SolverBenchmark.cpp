@@ -0,0 +1,68 @@
+#include "Physics/World.hpp"
+#include "Benchmark.hpp"
+
+using namespace FYC;
+using namespace FYC::Benchmarks;
+
+namespace {
+
+	struct Stack {
+		World Simulation;
+		std::vector<World::ID> Boxes;
+	};
+
+	/// A floor holding a column of boxes, or a pyramid when wide.
+	Stack CreateStack(const SolverType type, const int32_t height, const bool pyramid)
+	{
+		Stack stack;
+		stack.Simulation.Solver.Type = type;
+		stack.Simulation.AddParticle(Particle::CreateRectangle({0, 1}, {100, 1}))->SetKinematic(false);
+		for (int32_t row = 0; row < height; ++row) {
+			const int32_t width = pyramid ? height - row : 1;
+			for (int32_t column = 0; column < width; ++column) {
+				const Vec2 position{static_cast<Real>(column) - static_cast<Real>(width - 1) / 2, -static_cast<Real>(row)};
+				stack.Boxes.push_back(stack.Simulation.AddParticle(Particle::CreateRectangle(position, {1, 1}, {0, 0}, {0, 10})).GetID());
+			}
+		}
+		return stack;
+	}
+
+	void Run(const char* name, const SolverType type, const int32_t height, const bool pyramid)
+	{
+		constexpr uint32_t steps = 600;
+		Stack stack = CreateStack(type, height, pyramid);
+		std::vector<Vec2> start;
+		for (const World::ID id : stack.Boxes) start.push_back(stack.Simulation.GetParticle(id)->GetPosition());
+
+		uint64_t detectionPasses = 0;
+		const Clock::time_point begin = Clock::now();
+		for (uint32_t step = 0; step < steps; ++step) {
+			stack.Simulation.Step(Real{1} / 60);
+			detectionPasses += stack.Simulation.GetStepStatistics().DetectionPasses;
+		}
+		const double microseconds = ToMicroseconds(Clock::now() - begin) / steps;
+
+		// A stable stack settles where it was built.
+		Real drift{0};
+		for (size_t i = 0; i < stack.Boxes.size(); ++i) drift = std::max(drift, Math::Magnitude(stack.Simulation.GetParticle(stack.Boxes[i])->GetPosition() - start[i]));
+		std::printf("%-18s %s of %zu: %.2f detection passes per step, %.1f us per step, boxes moved by %.3f at most\n",
+			name, pyramid ? "pyramid" : "column ", stack.Boxes.size(), static_cast<double>(detectionPasses) / steps, microseconds, static_cast<double>(drift));
+	}
+
+}
+
+// Detection passes, step cost and stability of the solvers on stacked boxes after 10 seconds.
+int main()
+{
+	const std::pair<const char*, SolverType> solvers[] = {
+		{"Iterative", SolverType::Iterative},
+		{"Speculative", SolverType::Speculative},
+		{"SequentialImpulse", SolverType::SequentialImpulse},
+		{"Substepping", SolverType::Substepping},
+	};
+	for (const auto& [name, type] : solvers) {
+		Run(name, type, 10, false);
+		Run(name, type, 10, true);
+	}
+	return 0;
+}
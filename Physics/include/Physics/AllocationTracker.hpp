@@ -0,0 +1,12 @@
+#pragma once
+
+namespace FYC {
+
+	/**
+	 * Number of calls to the global operator new since the start of the program, on every thread.
+	 * Only counted when the library is built with FYC_TRACK_ALLOCATIONS, which replaces the global allocation functions.
+	 * Always 0 otherwise.
+	 */
+	[[nodiscard]] uint64_t GetAllocationCount();
+
+} // FYC
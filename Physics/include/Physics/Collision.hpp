@@ -20,12 +20,41 @@ namespace FYC {
 		[[nodiscard]] explicit operator bool() const {return IsColliding;}
 	};
 
+	struct TimeOfImpact {
+		Vec2 CollisionNormal;
+		Real Time; // Fraction of the movement, between 0 and 1, at which the shapes start touching.
+		bool IsHit;
+
+		[[nodiscard]] explicit operator bool() const {return IsHit;}
+	};
+
 	class CollisionDetector {
 	public:
-		[[nodiscard]] static Collision Collide(const Circle& a, const Circle& b);
-		[[nodiscard]] static Collision Collide(const AABB& a, const AABB& b);
-		[[nodiscard]] static Collision Collide(const Circle& a, const AABB& b);
-		[[nodiscard]] static Collision Collide(const AABB& a, const Circle& b);
+		/**
+		 * Check whether two shapes collide.
+		 * With a margin, shapes closer than the margin are also reported, with a negative interpenetration.
+		 * @param a The first shape
+		 * @param b The second shape
+		 * @param margin The distance under which separated shapes are reported as colliding
+		 * @return The collision, with a normal pointing from 'b' to 'a'
+		 */
+		[[nodiscard]] static Collision Collide(const Circle& a, const Circle& b, Real margin = 0);
+		[[nodiscard]] static Collision Collide(const AABB& a, const AABB& b, Real margin = 0);
+		[[nodiscard]] static Collision Collide(const Circle& a, const AABB& b, Real margin = 0);
+		[[nodiscard]] static Collision Collide(const AABB& a, const Circle& b, Real margin = 0);
+
+		/**
+		 * Sweep the shape 'a' along 'movement' against the shape 'b' which is considered still.
+		 * Shapes already overlapping and moving toward each other are reported as a hit at the start of the movement.
+		 * @param a The moving shape
+		 * @param movement The movement of 'a' relative to 'b'
+		 * @param b The still shape
+		 * @return The first time of impact, with a normal pointing from 'b' to 'a'
+		 */
+		[[nodiscard]] static TimeOfImpact Sweep(const Circle& a, const Vec2& movement, const Circle& b);
+		[[nodiscard]] static TimeOfImpact Sweep(const AABB& a, const Vec2& movement, const AABB& b);
+		[[nodiscard]] static TimeOfImpact Sweep(const Circle& a, const Vec2& movement, const AABB& b);
+		[[nodiscard]] static TimeOfImpact Sweep(const AABB& a, const Vec2& movement, const Circle& b);
 	};
 
 } // FYC
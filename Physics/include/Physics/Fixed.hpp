@@ -0,0 +1,182 @@
+#pragma once
+
+namespace FYC {
+
+	/**
+	 * Deterministic Q47.16 fixed-point number, the values are in (-2^47, 2^47) with a precision of 2^-16.
+	 * Every operation is done on integers so the results are bit-identical on every compiler and CPU.
+	 * Products and quotients are computed on 128 bits and saturate to the range instead of overflowing,
+	 * with __int128 when the compiler has it and an equivalent portable path otherwise.
+	 * Sums and differences aren't saturated, they must stay in the range.
+	 */
+	struct Fixed
+	{
+	public:
+		using RawType = int64_t;
+		inline static constexpr int FractionalBits = 16;
+		inline static constexpr RawType One = RawType(1) << FractionalBits;
+		inline static constexpr RawType MaxRaw = INT64_MAX;
+		inline static constexpr RawType MinRaw = -INT64_MAX;
+	public:
+		Fixed() = default;
+		~Fixed() = default;
+		Fixed(const Fixed&) = default;
+		Fixed& operator=(const Fixed&) = default;
+
+		template<typename T> requires std::is_integral_v<T>
+		constexpr Fixed(const T value) : Raw(static_cast<RawType>(value) * One) {}
+
+		template<typename T> requires std::is_floating_point_v<T>
+		constexpr Fixed(const T value) : Raw(FromFloating(value)) {}
+
+		[[nodiscard]] static constexpr Fixed FromRaw(const RawType raw) { Fixed result; result.Raw = raw; return result; }
+
+		template<typename T> requires std::is_arithmetic_v<T>
+		[[nodiscard]] explicit constexpr operator T() const
+		{
+			if constexpr (std::is_floating_point_v<T>) return static_cast<T>(Raw) / static_cast<T>(One);
+			else return static_cast<T>(Raw / One);
+		}
+	public:
+		[[nodiscard]] constexpr Fixed operator-() const { return FromRaw(-Raw); }
+		[[nodiscard]] constexpr Fixed operator+() const { return *this; }
+
+		constexpr Fixed& operator+=(const Fixed other) { Raw += other.Raw; return *this; }
+		constexpr Fixed& operator-=(const Fixed other) { Raw -= other.Raw; return *this; }
+		constexpr Fixed& operator*=(const Fixed other) { Raw = Multiply(Raw, other.Raw); return *this; }
+		constexpr Fixed& operator/=(const Fixed other) { Raw = Divide(Raw, other.Raw); return *this; }
+
+		[[nodiscard]] friend constexpr Fixed operator+(Fixed a, const Fixed b) { a += b; return a; }
+		[[nodiscard]] friend constexpr Fixed operator-(Fixed a, const Fixed b) { a -= b; return a; }
+		[[nodiscard]] friend constexpr Fixed operator*(Fixed a, const Fixed b) { a *= b; return a; }
+		[[nodiscard]] friend constexpr Fixed operator/(Fixed a, const Fixed b) { a /= b; return a; }
+
+		[[nodiscard]] friend constexpr bool operator==(const Fixed a, const Fixed b) { return a.Raw == b.Raw; }
+		[[nodiscard]] friend constexpr bool operator!=(const Fixed a, const Fixed b) { return a.Raw != b.Raw; }
+		[[nodiscard]] friend constexpr bool operator<(const Fixed a, const Fixed b) { return a.Raw < b.Raw; }
+		[[nodiscard]] friend constexpr bool operator>(const Fixed a, const Fixed b) { return a.Raw > b.Raw; }
+		[[nodiscard]] friend constexpr bool operator<=(const Fixed a, const Fixed b) { return a.Raw <= b.Raw; }
+		[[nodiscard]] friend constexpr bool operator>=(const Fixed a, const Fixed b) { return a.Raw >= b.Raw; }
+	public:
+		[[nodiscard]] static Fixed Abs(Fixed value);
+		[[nodiscard]] static Fixed Sqrt(Fixed value);
+		[[nodiscard]] static Fixed Sin(Fixed radian);
+		[[nodiscard]] static Fixed Cos(Fixed radian);
+	private:
+		template<typename T>
+		[[nodiscard]] static constexpr RawType FromFloating(const T value)
+		{
+			if (value != value) return 0; // NaN has no fixed-point representation.
+			const T scaled = value * static_cast<T>(One);
+			if (scaled >= static_cast<T>(MaxRaw)) return MaxRaw;
+			if (scaled <= static_cast<T>(MinRaw)) return MinRaw;
+			return static_cast<RawType>(scaled + (scaled < 0 ? T(-0.5) : T(0.5)));
+		}
+
+		[[nodiscard]] static constexpr RawType Multiply(const RawType a, const RawType b)
+		{
+#if defined(__SIZEOF_INT128__)
+			// Most products fit in 64 bits, only the ones that don't take the 128 bits path.
+			RawType narrow;
+			if (!__builtin_mul_overflow(a, b, &narrow) && narrow <= MaxRaw - (One >> 1)) return (narrow + (One >> 1)) >> FractionalBits;
+			return WideMultiply(a, b);
+#else
+			return PortableMultiply(a, b);
+#endif
+		}
+
+		[[nodiscard]] static constexpr RawType Divide(const RawType a, const RawType b)
+		{
+			if (b == 0) return a < 0 ? MinRaw : MaxRaw;
+			// The shifted dividend fits in 64 bits for most values, the 128 bits division is much slower.
+			if (a > -MaxShiftable && a < MaxShiftable) return (a << FractionalBits) / b;
+#if defined(__SIZEOF_INT128__)
+			return WideDivide(a, b);
+#else
+			return PortableDivide(a, b);
+#endif
+		}
+
+#if defined(__SIZEOF_INT128__)
+		// Kept out of the fast paths so these stay small enough to inline everywhere.
+		[[gnu::cold]] static constexpr RawType WideMultiply(const RawType a, const RawType b)
+		{
+			__extension__ using Wide = __int128;
+			const Wide product = (static_cast<Wide>(a) * b + (One >> 1)) >> FractionalBits;
+			if (product > MaxRaw) return MaxRaw;
+			if (product < MinRaw) return MinRaw;
+			return static_cast<RawType>(product);
+		}
+
+		[[gnu::cold]] static constexpr RawType WideDivide(const RawType a, const RawType b)
+		{
+			__extension__ using Wide = __int128;
+			const Wide quotient = (static_cast<Wide>(a) << FractionalBits) / b;
+			if (quotient > MaxRaw) return MaxRaw;
+			if (quotient < MinRaw) return MinRaw;
+			return static_cast<RawType>(quotient);
+		}
+#endif
+	public:
+		/// Multiply with the 128 bits intermediate built from 64 bits halves, used without __int128. Rounded to the nearest, saturated.
+		[[nodiscard]] static constexpr RawType PortableMultiply(const RawType a, const RawType b)
+		{
+			// Unsigned product of the two's complement values, then corrected to the signed product.
+			const auto ua = static_cast<uint64_t>(a);
+			const auto ub = static_cast<uint64_t>(b);
+			const uint64_t lowLow = (ua & 0xFFFFFFFFu) * (ub & 0xFFFFFFFFu);
+			const uint64_t lowHigh = (ua & 0xFFFFFFFFu) * (ub >> 32);
+			const uint64_t highLow = (ua >> 32) * (ub & 0xFFFFFFFFu);
+			const uint64_t highHigh = (ua >> 32) * (ub >> 32);
+			const uint64_t middle = (lowLow >> 32) + (lowHigh & 0xFFFFFFFFu) + (highLow & 0xFFFFFFFFu);
+			uint64_t low = (middle << 32) | (lowLow & 0xFFFFFFFFu);
+			uint64_t high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+			if (a < 0) high -= ub;
+			if (b < 0) high -= ua;
+
+			constexpr auto half = static_cast<uint64_t>(One >> 1);
+			low += half;
+			if (low < half) ++high;
+
+			const uint64_t resultLow = (low >> FractionalBits) | (high << (64 - FractionalBits));
+			const RawType resultHigh = static_cast<RawType>(high) >> FractionalBits;
+			// Fits in 64 bits when the high half is only the sign extension of the low one.
+			if (resultHigh != (static_cast<RawType>(resultLow) < 0 ? -1 : 0)) return resultHigh < 0 ? MinRaw : MaxRaw;
+			return std::max(static_cast<RawType>(resultLow), MinRaw);
+		}
+
+		/// Divide with a long division of the magnitudes, used without __int128. Truncated toward zero, saturated, b must not be 0.
+		[[nodiscard]] static constexpr RawType PortableDivide(const RawType a, const RawType b)
+		{
+			const bool isNegative = (a < 0) != (b < 0);
+			const uint64_t dividend = a < 0 ? 0 - static_cast<uint64_t>(a) : static_cast<uint64_t>(a);
+			const uint64_t divisor = b < 0 ? 0 - static_cast<uint64_t>(b) : static_cast<uint64_t>(b);
+
+			const uint64_t integer = dividend / divisor;
+			if (integer > static_cast<uint64_t>(MaxRaw) >> FractionalBits) return isNegative ? MinRaw : MaxRaw;
+			// The remainder is under the divisor, so under 2^63, and its double still fits.
+			uint64_t remainder = dividend % divisor;
+			uint64_t fraction = 0;
+			for (int i = 0; i < FractionalBits; ++i) {
+				remainder <<= 1;
+				fraction <<= 1;
+				if (remainder >= divisor) {
+					remainder -= divisor;
+					fraction |= 1;
+				}
+			}
+
+			const auto magnitude = static_cast<RawType>((integer << FractionalBits) | fraction);
+			return isNegative ? -magnitude : magnitude;
+		}
+	private:
+		/// Bound of the raw values that can be shifted by FractionalBits without overflowing.
+		inline static constexpr RawType MaxShiftable = RawType(1) << (63 - FractionalBits);
+	public:
+		RawType Raw;
+	};
+
+	static_assert(std::is_trivially_copyable_v<Fixed>);
+	static_assert(sizeof(Fixed) == sizeof(Fixed::RawType));
+
+} // FYC
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace FYC {
+
+	template<typename Signature>
+	class FunctionRef;
+
+	/**
+	 * Non-owning reference to a callable, a pointer to it and a pointer to a function invoking it.
+	 * Unlike std::function it never allocates and can't be empty, but the callable must outlive it:
+	 * take it as a parameter, never store it.
+	 */
+	template<typename Result, typename... Args>
+	class FunctionRef<Result(Args...)>
+	{
+	public:
+		template<typename Function>
+		requires (!std::is_same_v<std::remove_cvref_t<Function>, FunctionRef> && std::is_invocable_r_v<Result, Function&, Args...>)
+		FunctionRef(Function&& function) noexcept :
+			m_Invoke([](void* callable, Args... args) -> Result {
+				using Callable = std::remove_reference_t<Function>;
+				if constexpr (std::is_function_v<Callable>) return std::invoke(reinterpret_cast<Callable*>(callable), std::forward<Args>(args)...);
+				else return std::invoke(*static_cast<Callable*>(callable), std::forward<Args>(args)...);
+			})
+		{
+			// A function isn't an object, its address can only be kept through a cast.
+			if constexpr (std::is_function_v<std::remove_reference_t<Function>>) m_Callable = reinterpret_cast<void*>(&function);
+			else m_Callable = const_cast<void*>(static_cast<const void*>(std::addressof(function)));
+		}
+
+		Result operator()(Args... args) const
+		{
+			return m_Invoke(m_Callable, std::forward<Args>(args)...);
+		}
+	private:
+		void* m_Callable;
+		Result (*m_Invoke)(void*, Args...);
+	};
+
+} // FYC
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Physics/FunctionRef.hpp"
+
+namespace FYC {
+
+	/**
+	 * Small work-stealing job system running data-parallel loops.
+	 * A loop is cut in chunks of a fixed grain size, every thread starts with a contiguous share of the chunks
+	 * and steals half of the remaining chunks of another thread once its own share is done.
+	 * The chunks always cover the same indices, a job writing its results per chunk and merging them in chunk order
+	 * gets the same result whatever thread ran which chunk.
+	 */
+	class JobSystem
+	{
+	public:
+		/// Called with the [begin, end) indices of one chunk. The loop waits for every chunk, so a reference is enough.
+		using RangeJob = FunctionRef<void(uint32_t begin, uint32_t end)>;
+	public:
+		/**
+		 * @param threadCount Number of threads running the loops, the calling thread included.
+		 */
+		explicit JobSystem(uint32_t threadCount);
+		~JobSystem();
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+	public:
+		[[nodiscard]] uint32_t GetThreadCount() const;
+
+		/// Number of chunks ParallelFor cuts [0, count) in, chunk c starts at c * grainSize.
+		[[nodiscard]] static uint32_t GetChunkCount(uint32_t count, uint32_t grainSize);
+
+		/**
+		 * Run the job over [0, count) cut in chunks of grainSize indices, and return once every chunk is done.
+		 * The calling thread works on the chunks too. A loop started from inside a job runs serially on its thread.
+		 * @param count Number of indices to process.
+		 * @param grainSize Number of indices per chunk.
+		 * @param job Function processing one chunk.
+		 */
+		void ParallelFor(uint32_t count, uint32_t grainSize, RangeJob job);
+	private:
+		/// Chunks left to a thread, packed as (begin << 32 | end) so both ends move with a single atomic operation.
+		struct alignas(64) ChunkQueue {
+			std::atomic<uint64_t> Chunks{0};
+		};
+	private:
+		void WorkerLoop(uint32_t thread);
+		void RunChunks(uint32_t thread);
+		[[nodiscard]] bool PopChunk(uint32_t thread, uint32_t& chunk);
+		[[nodiscard]] bool StealChunk(uint32_t thread, uint32_t& chunk);
+		void RunChunk(uint32_t chunk) const;
+	private:
+		std::vector<std::thread> m_Workers;
+		std::unique_ptr<ChunkQueue[]> m_Queues;
+		std::mutex m_DispatchMutex;
+		std::mutex m_Mutex;
+		std::condition_variable m_WorkAvailable;
+		std::condition_variable m_WorkersIdle;
+		uint32_t m_ActiveWorkers = 0;
+		uint64_t m_Generation = 0;
+		bool m_Stopping = false;
+
+		const RangeJob* m_Job = nullptr;
+		uint32_t m_Count = 0;
+		uint32_t m_GrainSize = 1;
+		std::atomic<uint32_t> m_RemainingChunks{0};
+	};
+
+} // FYC
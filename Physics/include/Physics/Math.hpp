@@ -4,9 +4,23 @@
 
 #pragma once
 
+#include "Physics/Fixed.hpp"
+
 namespace FYC {
 
-#ifdef FYC_DOUBLE
+#if defined(FYC_FIXED)
+	#define REAL_DECIMAL_DIG	6										// # of decimal digits of rounding precision
+	#define REAL_DIG			4										// # of decimal digits of precision
+	#define REAL_EPSILON		(::FYC::Fixed::FromRaw(1))				// smallest such that 1.0+REAL_EPSILON != 1.0
+	#define REAL_HAS_SUBNORM	0										// type does not support subnormal numbers
+	#define REAL_MANT_DIG		63										// # of bits in mantissa
+	#define REAL_MAX			(::FYC::Fixed::FromRaw(::FYC::Fixed::MaxRaw))	// max value
+	#define REAL_MIN			(::FYC::Fixed::FromRaw(1))				// min positive value
+	#define REAL_RADIX			2										// exponent radix
+	#define REAL_TRUE_MIN		(::FYC::Fixed::FromRaw(1))				// min positive value
+
+	using Real = Fixed;
+#elif defined(FYC_DOUBLE)
 	#define REAL_DECIMAL_DIG	DBL_DECIMAL_DIG		// # of decimal digits of rounding precision
 	#define REAL_DIG			DBL_DIG				// # of decimal digits of precision
 	#define REAL_EPSILON		DBL_EPSILON			// smallest such that 1.0+DBL_EPSILON != 1.0
@@ -52,11 +66,16 @@ namespace FYC {
 
 	struct Vec2
 	{
+#if defined(FYC_FIXED)
+		// Anonymous aggregates cannot hold a type with constructors, the components are stored directly.
+		Real x, y;
+#else
 		union
 		{
 			struct {Real x, y;};
 			Real data[2];
 		};
+#endif
 
 		Vec2() : x(0), y(0) {}
 		explicit Vec2(Real value) : x(value), y(value) {}
@@ -84,23 +103,28 @@ namespace FYC {
 		Vec2& operator /=(Real value) {Real inv = Real(1) / value; *this *= inv; return *this;}
 		[[nodiscard]] Vec2 operator /(Real value) const {Vec2 result{*this}; result /= value; return result;}
 
-		[[nodiscard]] Real& operator[](const unsigned int index) {return data[index];}
-		[[nodiscard]] const Real& operator[](const unsigned int index) const  {return data[index];}
+		[[nodiscard]] Real& operator[](const unsigned int index) {return index == 0 ? x : y;}
+		[[nodiscard]] const Real& operator[](const unsigned int index) const  {return index == 0 ? x : y;}
 	};
 
 	struct Mat2x2
 	{
+#if defined(FYC_FIXED)
+		// Anonymous aggregates cannot hold a type with constructors, the components are stored directly.
+		Real c00, c01, c10, c11;
+#else
 		union
 		{
 			struct {Real c00, c01, c10, c11;};
 			Vec2 columns[2];
 			Real data[4];
 		};
+#endif
 
 		Mat2x2() : c00(1), c01(0), c10(0), c11(1) {}
 		explicit Mat2x2(Real value) : c00(value), c01(value), c10(value), c11(value) {}
 		Mat2x2(Real c_00, Real c_10, Real c_01, Real c_11) : c00(c_00), c01(c_01), c10(c_10), c11(c_11) {}
-		Mat2x2(const Vec2& col1, const Vec2& col2) : columns{col1, col2} {}
+		Mat2x2(const Vec2& col1, const Vec2& col2) : c00(col1.x), c01(col1.y), c10(col2.x), c11(col2.y) {}
 		Mat2x2(const Mat2x2& other) : c00(other.c00), c01(other.c01), c10(other.c10), c11(other.c11) {}
 		~Mat2x2() = default;
 
@@ -135,20 +159,22 @@ namespace FYC {
 		Mat2x2& operator *=(const Mat2x2& other) { Mat2x2 result = *this * other; *this = result; return *this; }
 
 
-		[[nodiscard]] Vec2 GetCol(unsigned int col) const {return columns[col];}
-		[[nodiscard]] Vec2 GetRow(unsigned int row) const {return {columns[0][row],columns[1][row]};}
+		[[nodiscard]] Vec2 GetCol(unsigned int col) const {return {(*this)(col, 0), (*this)(col, 1)};}
+		[[nodiscard]] Vec2 GetRow(unsigned int row) const {return {(*this)(0, row), (*this)(1, row)};}
 
-		void SetCol(unsigned int col, Vec2 colData) {columns[col] = colData;}
-		void SetRow(unsigned int row, Vec2 rowData) {columns[0][row] = rowData[0]; columns[1][row] = rowData[1];}
+		void SetCol(unsigned int col, Vec2 colData) {(*this)(col, 0) = colData[0]; (*this)(col, 1) = colData[1];}
+		void SetRow(unsigned int row, Vec2 rowData) {(*this)(0, row) = rowData[0]; (*this)(1, row) = rowData[1];}
 
+#if !defined(FYC_FIXED)
 		[[nodiscard]] Vec2& operator[](unsigned int col) {return columns[col];}
 		[[nodiscard]] const Vec2& operator[](unsigned int col) const {return columns[col];}
+#endif
 
-		[[nodiscard]] Real& operator()(unsigned int col, unsigned int row) {return columns[col][row];}
-		[[nodiscard]] const Real& operator()(unsigned int col, unsigned int row) const {return columns[col][row];}
+		[[nodiscard]] Real& operator()(unsigned int col, unsigned int row) {return (*this)(col * 2 + row);}
+		[[nodiscard]] const Real& operator()(unsigned int col, unsigned int row) const {return (*this)(col * 2 + row);}
 
-		[[nodiscard]] Real& operator()(unsigned int index) {return data[index];}
-		[[nodiscard]] const Real& operator()(unsigned int index) const {return data[index];}
+		[[nodiscard]] Real& operator()(unsigned int index) {return index == 0 ? c00 : index == 1 ? c01 : index == 2 ? c10 : c11;}
+		[[nodiscard]] const Real& operator()(unsigned int index) const {return index == 0 ? c00 : index == 1 ? c01 : index == 2 ? c10 : c11;}
 	};
 
 	using Mat2 = Mat2x2;
@@ -162,7 +188,11 @@ namespace FYC {
 		inline static constexpr Real rad2deg {static_cast<Real>(180) / pi};
 
 		[[nodiscard]] Real Sign(Real value);
+		[[nodiscard]] Real Abs(Real value);
 		[[nodiscard]] Real Clamp(Real value, Real min, Real max);
+		[[nodiscard]] Real Sqrt(Real value);
+		[[nodiscard]] Real Sin(Real radianAngle);
+		[[nodiscard]] Real Cos(Real radianAngle);
 		[[nodiscard]] Real Dot(const Vec2& a, const Vec2& b);
 		[[nodiscard]] Real MagnitudeSqr(const Vec2& vec);
 		[[nodiscard]] Real Magnitude(const Vec2& vec);
@@ -0,0 +1,110 @@
+#pragma once
+
+namespace FYC {
+
+	struct MemoryUsage {
+		/// Bytes handed out and not given back yet.
+		uint64_t Bytes = 0;
+		/// Most bytes handed out at once since the resource was created or its peak reset.
+		uint64_t PeakBytes = 0;
+		/// Number of allocations since the resource was created.
+		uint64_t Allocations = 0;
+	};
+
+	/// Thread safe count of the bytes a resource hands out.
+	class MemoryCounter
+	{
+	public:
+		void Allocate(std::size_t bytes);
+		void Deallocate(std::size_t bytes);
+		[[nodiscard]] MemoryUsage GetUsage() const;
+		/// Restart the peak from the bytes currently handed out.
+		void ResetPeak();
+	private:
+		std::atomic<uint64_t> m_Bytes{0};
+		std::atomic<uint64_t> m_PeakBytes{0};
+		std::atomic<uint64_t> m_Allocations{0};
+	};
+
+	/**
+	 * Forwards to an upstream resource and counts what goes through it, from any thread.
+	 * Wrap a resource of your own, one backed by huge pages for instance, to know what a world takes from it.
+	 */
+	class CountingResource : public std::pmr::memory_resource
+	{
+	public:
+		explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+	public:
+		[[nodiscard]] MemoryUsage GetUsage() const;
+		void ResetPeak();
+		[[nodiscard]] std::pmr::memory_resource* GetUpstream() const;
+	private:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+		[[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+	private:
+		std::pmr::memory_resource* m_Upstream;
+		MemoryCounter m_Counter;
+	};
+
+	/**
+	 * Pool holding the memory of the worlds of a session, thread safe so the job system can grow the per chunk buffers.
+	 * The freed blocks are kept for the next allocations of their size, the vectors of the step regrowing after a clear
+	 * and the particles added after others were removed reuse them. Everything goes back to the upstream at once when
+	 * the pool is released or destroyed.
+	 */
+	class PoolResource : public std::pmr::memory_resource
+	{
+	public:
+		explicit PoolResource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+	public:
+		/// What the worlds using the pool hold.
+		[[nodiscard]] MemoryUsage GetUsage() const;
+		/// What the pool holds from its upstream, the freed blocks it keeps included.
+		[[nodiscard]] MemoryUsage GetUpstreamUsage() const;
+		void ResetPeak();
+		/// Give every block back to the upstream. Nothing allocated from the pool may be used afterward.
+		void Release();
+	private:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+		[[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+	private:
+		CountingResource m_Upstream;
+		std::pmr::synchronized_pool_resource m_Pool;
+		MemoryCounter m_Counter;
+	};
+
+	/**
+	 * Monotonic buffer for a world built once and dropped in one go: allocating is a pointer bump and freeing does nothing,
+	 * the memory only goes back to the upstream when the resource is released or destroyed.
+	 * Suits a world whose containers stop growing after a few steps, a world adding and removing particles for ever keeps growing it.
+	 * The allocations are serialized by a lock so the job system can use it too.
+	 */
+	class MonotonicResource : public std::pmr::memory_resource
+	{
+	public:
+		/// @param initialSize Size of the first buffer asked to the upstream, the next ones grow geometrically.
+		explicit MonotonicResource(std::size_t initialSize = 1 << 18, std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+		/// Start with a buffer of the caller, huge-page memory for instance. The upstream is only used once it is full.
+		explicit MonotonicResource(std::span<std::byte> buffer, std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+	public:
+		/// What the worlds using the resource hold, the bytes freed count as given back even though they are not reused.
+		[[nodiscard]] MemoryUsage GetUsage() const;
+		/// What the resource took from its upstream, the buffer of the caller excluded.
+		[[nodiscard]] MemoryUsage GetUpstreamUsage() const;
+		void ResetPeak();
+		/// Give every buffer back to the upstream and start over. Nothing allocated from the resource may be used afterward.
+		void Release();
+	private:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+		[[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+	private:
+		CountingResource m_Upstream;
+		std::mutex m_Mutex;
+		std::pmr::monotonic_buffer_resource m_Buffer;
+		MemoryCounter m_Counter;
+	};
+
+} // FYC
@@ -11,6 +11,26 @@
 namespace FYC {
 	class World;
 
+	/// Bits naming the state of a particle changed since the world last cleared its changes, the solver state (previous position, time asleep) isn't tracked.
+	struct ParticleChange {
+		using Mask = uint8_t;
+		static constexpr Mask None = 0;
+		/// Position of the shape.
+		static constexpr Mask Position = 1u << 0;
+		static constexpr Mask Velocity = 1u << 1;
+		/// Constant accelerations, the accelerations summed for a single step aren't tracked.
+		static constexpr Mask Accelerations = 1u << 2;
+		/// Rebound and drag.
+		static constexpr Mask Material = 1u << 3;
+		/// Whether the particle is kinematic, awake, a bullet or a sensor.
+		static constexpr Mask State = 1u << 4;
+		/// Type and size of the shape.
+		static constexpr Mask Shape = 1u << 5;
+		/// The particle was created or replaced as a whole, every part of it is new including its user data.
+		static constexpr Mask Created = 1u << 7;
+		static constexpr Mask All = 0xFF;
+	};
+
 	class Particle
 	{
 		friend class World;
@@ -55,6 +75,22 @@ namespace FYC {
 		void SetKinematic(bool isKinematic);
 		[[nodiscard]] bool IsKinematic() const;
 
+		/**
+		 * A bullet is swept along its movement during the integration so it can't tunnel through thin particles,
+		 * no matter how big the step is. It costs a sweep against every other particle, keep it for fast particles.
+		 * @param isBullet Whether the particle use continuous collision detection
+		 */
+		void SetBullet(bool isBullet);
+		[[nodiscard]] bool IsBullet() const;
+
+		/**
+		 * A sensor is only tested for overlaps with the kinematic particles, reported through the world sensor listeners.
+		 * It is ignored by the solver and the bounds: nothing pushes it, it pushes nothing and the step doesn't move it.
+		 * @param isSensor Whether the particle is a sensor
+		 */
+		void SetSensor(bool isSensor);
+		[[nodiscard]] bool IsSensor() const;
+
 		void SetRebound(Real rebound);
 		[[nodiscard]] Real GetRebound() const;
 
@@ -67,6 +103,10 @@ namespace FYC {
 		void SetIsAwake(bool isAwake);
 
 		[[nodiscard]] Real GetInverseMass() const;
+
+		/// What the setters and the steps changed since the last ClearChanges. A new particle is all changed.
+		[[nodiscard]] ParticleChange::Mask GetChanges() const { return m_Changes; }
+		void ClearChanges() { m_Changes = ParticleChange::None; }
 	public:
 		void swap(Particle& other) noexcept;
 	public:
@@ -76,6 +116,8 @@ namespace FYC {
 		template<typename T>
 		bool HasShape(T& value) const { const T* valuePtr = nullptr; if ((valuePtr = std::get_if<T>(&m_Shape))) value = *valuePtr; return valuePtr; }
 
+		[[nodiscard]] const Shape& GetShape() const { return m_Shape; }
+
 		[[nodiscard]] std::optional<Real> GetCircleRadius() const;
 
 		/**
@@ -122,5 +164,10 @@ namespace FYC {
 		Real m_AsleepDuration{0};
 		bool m_IsKinematic = true;
 		bool m_IsAwake = true;
+		bool m_IsBullet = false;
+		bool m_IsSensor = false;
+		ParticleChange::Mask m_Changes = ParticleChange::All;
+		/// Index of the particle in the solver bodies of the current pass, set by the world.
+		uint32_t m_SolverBody = ~0u;
 	};
 } // FYC
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Physics/Math.hpp"
+#include "Physics/World.hpp"
+
+namespace FYC {
+
+	/**
+	 * Steps a world with a fixed step time, whatever the frame rate.
+	 * The elapsed time is accumulated and consumed by whole steps, the leftover is exposed as an interpolation factor
+	 * so the rendering can blend between the two last simulated states.
+	 */
+	class StepDriver
+	{
+	public:
+		using StepCallback = std::function<void(Real stepTime)>;
+	public:
+		/**
+		 * @param fixedStepTime The simulated time of every step
+		 * @param maxStepsPerUpdate The most steps a single update may run, the time that would need more is dropped
+		 */
+		explicit StepDriver(Real fixedStepTime = Real(1) / Real(60), uint32_t maxStepsPerUpdate = 5);
+		~StepDriver();
+	public:
+		/**
+		 * Accumulate the elapsed time and step the world as many times as it covers.
+		 * @param world The world to step
+		 * @param elapsedTime The real time elapsed since the last update
+		 * @param beforeStep Called before every step, to drive the particles
+		 * @param afterStep Called after every step
+		 * @return The number of steps that ran
+		 */
+		uint32_t Update(World& world, Real elapsedTime, const StepCallback& beforeStep = {}, const StepCallback& afterStep = {});
+
+		/// Forget the accumulated time and the previous positions, to call when the world is replaced.
+		void Reset();
+
+		/// How far the accumulated time is into the next step, from 0 to 1.
+		[[nodiscard]] Real GetAlpha() const;
+
+		/// Position of the particle before the last step, or its current one if it didn't exist then.
+		[[nodiscard]] Vec2 GetPreviousPosition(World::ID id, const Particle& particle) const;
+
+		/// Position of the particle blended between the two last steps with GetAlpha.
+		[[nodiscard]] Vec2 GetInterpolatedPosition(World::ID id, const Particle& particle) const;
+	public:
+		[[nodiscard]] Real GetFixedStepTime() const;
+		void SetFixedStepTime(Real fixedStepTime);
+
+		[[nodiscard]] uint32_t GetMaxStepsPerUpdate() const;
+		void SetMaxStepsPerUpdate(uint32_t maxStepsPerUpdate);
+
+		/// Wall-clock budget given to every step, see World::Step.
+		[[nodiscard]] World::Clock::duration GetStepBudget() const;
+		void SetStepBudget(World::Clock::duration stepBudget);
+
+		/// Simulated time dropped since the last reset because an update needed more than GetMaxStepsPerUpdate steps.
+		[[nodiscard]] Real GetDroppedTime() const;
+	private:
+		void SavePreviousPositions(World& world);
+	private:
+		std::unordered_map<World::ID, Vec2> m_PreviousPositions;
+		Real m_FixedStepTime;
+		Real m_Accumulator{0};
+		Real m_DroppedTime{0};
+		uint32_t m_MaxStepsPerUpdate;
+		World::Clock::duration m_StepBudget = World::Clock::duration::max();
+	};
+
+} // FYC
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Physics/Math.hpp"
+#include "Physics/JobSystem.hpp"
+
+namespace FYC {
+
+	class World;
+
+	/// Bits naming the state of a world a step stage reads or writes.
+	struct StepResource {
+		using Mask = uint32_t;
+		static constexpr Mask None = 0;
+		static constexpr Mask Positions = 1u << 0;
+		static constexpr Mask Velocities = 1u << 1;
+		/// Constant and summed accelerations of the particles.
+		static constexpr Mask Accelerations = 1u << 2;
+		/// Whether the particles are awake.
+		static constexpr Mask Awake = 1u << 3;
+		/// How long the particles have been still, and the particles about to sleep.
+		static constexpr Mask SleepTimers = 1u << 4;
+		/// Collisions, broadphase pairs and solver contacts of the step.
+		static constexpr Mask Contacts = 1u << 5;
+		static constexpr Mask Statistics = 1u << 6;
+		/// The set of particles and callbacks, anything that adds or removes them.
+		static constexpr Mask Structure = 1u << 7;
+		/// The command buffer of the world, anything recording into it.
+		static constexpr Mask Commands = 1u << 8;
+		/// First bit free for the resources of the stages added by the user.
+		static constexpr Mask User = 1u << 16;
+		static constexpr Mask All = ~0u;
+	};
+
+	struct StepStage {
+		using Function = std::function<void(World& world, Real stepTime)>;
+
+		std::string Name;
+		StepResource::Mask Reads = StepResource::None;
+		StepResource::Mask Writes = StepResource::None;
+		Function Run;
+		/// Stages that must be done first, on top of the ones the resources already order. Unknown names are ignored.
+		std::vector<std::string> After{};
+	};
+
+	/**
+	 * Ordered list of stages run as a dependency graph.
+	 * A stage waits for every earlier stage it conflicts with, one writing what the other reads or writes,
+	 * and for the stages it names in After. The stages left independent run at the same time on the job system,
+	 * with the same result as running the list in order as long as their resources are declared honestly.
+	 */
+	class StepGraph
+	{
+	public:
+		/**
+		 * @param stage The stage to add, its name must be unique
+		 * @param before The stage to insert it before, empty to add it last
+		 * @return Whether the stage was added, it isn't if its name is taken or the stage to insert it before doesn't exist
+		 */
+		bool AddStage(StepStage stage, const std::string& before = {});
+		bool RemoveStage(const std::string& name);
+		[[nodiscard]] bool HasStage(const std::string& name) const;
+		[[nodiscard]] const std::vector<StepStage>& GetStages() const;
+
+		/// Indices of the stages grouped by the order they can run in, the stages of a wave don't depend on each other.
+		[[nodiscard]] const std::vector<std::vector<uint32_t>>& GetWaves();
+
+		/// Run every stage, one wave after the other. Loops started by the stages of a shared wave run serially.
+		void Run(World& world, Real stepTime, JobSystem* jobSystem);
+	private:
+		[[nodiscard]] std::vector<StepStage>::const_iterator FindStage(const std::string& name) const;
+		void BuildWaves();
+	private:
+		std::vector<StepStage> m_Stages;
+		std::vector<std::vector<uint32_t>> m_Waves;
+		bool m_IsDirty = true;
+	};
+
+} // FYC
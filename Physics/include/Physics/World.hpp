@@ -8,6 +8,10 @@
 #include "Physics/AABB.hpp"
 #include "Physics/Particle.hpp"
 #include "Physics/Collision.hpp"
+#include "Physics/JobSystem.hpp"
+#include "Physics/StepGraph.hpp"
+#include "Physics/FunctionRef.hpp"
+#include "Physics/AllocationTracker.hpp"
 
 namespace FYC {
 
@@ -20,9 +24,98 @@ namespace FYC {
 		}
 	};
 
+	enum class SolverType : uint8_t {
+		/// Resolve every collision, then detect again, until nothing collides or the iterations run out.
+		Iterative,
+		/// Detect once with a margin based on the relative velocities, then solve the contacts as velocity constraints.
+		Speculative,
+		/// Speculative contacts solved with clamped accumulated impulses, warm started from the previous step.
+		SequentialImpulse,
+		/// Detect once, then split the step in small substeps that each project the contacts once on the positions (XPBD).
+		Substepping,
+	};
+
+	struct SolverSettings {
+		SolverType Type = SolverType::Iterative;
+		uint32_t Iterations = 10;
+		/// The velocity constraints stop iterating once no contact changed its velocity by more than this.
+		Real Tolerance = 0.0001;
+		bool WarmStarting = true;
+		/// Threads running the parallel phases of a step, the calling one included.
+		/// Every phase is cut in fixed chunks merged in order, so the result doesn't depend on this count.
+		uint32_t ThreadCount = 1;
+		/// Substeps of the Substepping solver.
+		uint32_t Substeps = 8;
+		/// Compliance (inverse stiffness) of the contacts of the Substepping solver, 0 for rigid contacts.
+		Real Compliance = 0;
+	};
+
+	struct StepStatistics {
+		uint32_t DetectionPasses = 0;
+		uint32_t SolverIterations = 0;
+		uint64_t ContactCount = 0;
+		/// Number of independent contact batches of the velocity solves, summed over the substeps.
+		uint32_t ContactBatches = 0;
+		/// Candidate pairs found by the broadphase of a substepped step.
+		uint64_t BroadphasePairs = 0;
+		std::chrono::steady_clock::duration Duration{};
+		/// Heap allocations made during the step on every thread, only counted with FYC_TRACK_ALLOCATIONS.
+		uint64_t HeapAllocations = 0;
+
+		// What a time-budgeted step skipped to stay in its budget.
+		/// The solver stopped before its tolerance or its iteration count, the contacts may be less converged.
+		bool SolverIterationsCut = false;
+		/// The remaining substeps were merged in a single bigger one.
+		bool SubstepsMerged = false;
+		/// The particles weren't checked for sleep, the time they have been still didn't advance.
+		bool SleepDeferred = false;
+		/// The contact impulses weren't kept for warm starting, the next step starts cold.
+		bool WarmStartSkipped = false;
+
+		[[nodiscard]] bool IsDegraded() const { return SolverIterationsCut || SubstepsMerged || SleepDeferred || WarmStartSkipped; }
+	};
+
+	/// Bytes a world holds per part, the unused capacity of its containers included.
+	struct MemoryStats {
+		/// The particles, their hash table and the per step lists of particles.
+		uint64_t Particles = 0;
+		/// Collisions, contacts kept between steps, warm start impulses and solver buffers.
+		uint64_t Contacts = 0;
+		/// Contact and sensor events, sensor overlaps and the records sent to the collision listeners.
+		uint64_t Events = 0;
+		/// Collision, contact and sensor listeners and the stages of the step graph.
+		uint64_t Callbacks = 0;
+		/// Bounds and candidate pairs of the broadphase.
+		uint64_t Broadphase = 0;
+		/// The command buffer of the world and the commands being applied.
+		uint64_t Commands = 0;
+		/// What the user data of the particles hold outside of the particles, only when measured.
+		uint64_t UserData = 0;
+
+		[[nodiscard]] uint64_t GetTotal() const { return Particles + Contacts + Events + Callbacks + Broadphase + Commands + UserData; }
+	};
+
+	/// Kind of a contact event. The listeners receive them in the order Persist, Begin, End, not the order of the values.
+	enum class ContactEventType : uint8_t {
+		/// The particles started touching during the step.
+		Begin,
+		/// The particles were already touching at the previous step.
+		Persist,
+		/// The particles stopped touching, or stopped being tested because they both fell asleep or one was removed.
+		End,
+	};
+
+	/// The events a contact listener receives.
+	struct ContactEventFilter {
+		bool Begin = true;
+		bool Persist = true;
+		bool End = true;
+	};
+
 	class World {
 	public:
 		using ID = uint64_t;
+		using Clock = std::chrono::steady_clock;
 		inline static constexpr ID NULL_ID = ~0ull;
 		class WorldIterator {
 		public:
@@ -58,17 +151,173 @@ namespace FYC {
 			World* m_World = nullptr;
 			ID m_ParticleId = NULL_ID;
 		};
-		using Callback = std::function<void(WorldIterator, WorldIterator, Collision)>;
+		/// Contact of a listened particle during a step.
+		struct CollisionRecord {
+			/// The listened particle.
+			ID Id;
+			/// The particle it touched, NULL_ID for the bounds.
+			ID OtherId;
+			Collision Contact;
+		};
+
+		/// Receives the contacts of every particle it listens to, in a single call per step.
+		class CollisionListener {
+		public:
+			virtual ~CollisionListener() = default;
+			/// @param records The contacts of the listened particles during the step, in no particular order
+			virtual void OnCollisions(World& world, std::span<const CollisionRecord> records) = 0;
+		};
+
+		struct ContactEvent {
+			ContactEventType Type;
+			/// The pair is ordered, IdA < IdB, and IdB is NULL_ID for a contact with the bounds.
+			ID IdA;
+			ID IdB;
+			/// The contact of the step, or the last one seen for an End event.
+			Collision Contact;
+		};
+
+		using ContactListener = std::function<void(std::span<const ContactEvent> events)>;
+		using ContactListenerHandle = uint32_t;
+
+		struct SensorEvent {
+			/// Begin when the particle starts overlapping the sensor, End when it stops or one of them is removed.
+			ContactEventType Type;
+			ID SensorId;
+			ID OtherId;
+		};
+
+		using SensorListener = std::function<void(std::span<const SensorEvent> events)>;
+		using SensorListenerHandle = uint32_t;
+
+		/**
+		 * Particles to add, set or remove, recorded now and applied to a world later in a single pass.
+		 * A buffer belongs to the thread recording into it, every job or chunk records in its own so none needs a lock.
+		 */
+		class CommandBuffer {
+			friend class World;
+		public:
+			explicit CommandBuffer(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+		public:
+			/// Queue a particle to add, its ID is given when the buffer is applied, in the order the particles were queued.
+			void AddParticle(Particle particle);
+			void SetParticle(Particle particle, ID id);
+			void RemoveParticle(ID id);
+
+			[[nodiscard]] bool IsEmpty() const;
+			void Clear();
+		private:
+			enum class CommandType : uint8_t { Add, Set, Remove };
+			struct Command {
+				CommandType Type;
+				ID Id;
+				/// Index in m_Particles of the particle to add or set.
+				uint32_t ParticleIndex;
+			};
+		private:
+			std::pmr::vector<Command> m_Commands;
+			std::pmr::vector<Particle> m_Particles;
+		};
+
+		/**
+		 * The state a simulation changes, taken from a world to put it back there cheaply, to restart a level for instance.
+		 * The particles are kept as a flat array of their state, the user data left out, restored in a single pass.
+		 * Full copies of the particles are only used to bring back the ones removed since, and are shared by the copies of a snapshot.
+		 */
+		class Snapshot {
+			friend class World;
+		private:
+			/// Everything of a particle but its user data.
+			struct ParticleState {
+				ID Id;
+				Particle::Shape Shape;
+				Vec2 Velocity;
+				Vec2 ConstantAccelerations;
+				Vec2 SummedAccelerations;
+				Vec2 PreviousPosition;
+				Real Rebound;
+				Real Drag;
+				Real AsleepDuration;
+				bool IsKinematic;
+				bool IsAwake;
+				bool IsBullet;
+				bool IsSensor;
+			};
+		private:
+			/// In the order the world iterated its particles, the order they are met again as long as none was added or removed.
+			std::vector<ParticleState> m_States;
+			/// The particles of m_States, in the same order.
+			std::shared_ptr<const std::vector<Particle>> m_Particles;
+			/// Index in m_States of every particle, sorted by ID.
+			std::vector<std::pair<ID, uint32_t>> m_Indices;
+			std::vector<std::pair<std::pair<ID, ID>, Collision>> m_ActiveContacts;
+			std::vector<std::pair<std::pair<ID, ID>, Real>> m_ContactImpulses;
+			std::vector<std::pair<ID, ID>> m_ActiveSensorOverlaps;
+			ID m_IDGenerator{0ull};
+		};
+	private:
+		struct SolverBody {
+			Particle* Body;
+			Vec2 Velocity;
+			Real InverseMass;
+			/// Bit mask of the contact batches already moving this particle.
+			uint64_t Batches;
+			Vec2 Position;
+			Vec2 PreviousPosition;
+			Vec2 Acceleration;
+		};
+
+		struct SolverContact {
+			std::pair<ID, ID> Key;
+			uint32_t BodyA;
+			uint32_t BodyB;
+			Collision Contact;
+			Real NormalMass;
+			Real TargetVelocity;
+			Real Impulse;
+			uint32_t Batch;
+			/// Whether the position solver pushed the particles apart during the current substep.
+			bool IsTouching;
+		};
+
+		struct BroadphaseBox {
+			AABB Bounds;
+			ID Id;
+			Particle* Body;
+		};
+
+		struct BroadphasePair {
+			ID IdA;
+			Particle* BodyA;
+			ID IdB;
+			Particle* BodyB;
+		};
+
+		/// Where a body stands relative to its particle when a sweep starts, and how far it moves during the sweep.
+		struct SweptMotion {
+			Vec2 Offset;
+			Vec2 Movement;
+		};
 	public:
 		World();
 		explicit World(uint64_t reserveParticleCount);
+		/**
+		 * World whose particles, contacts and listeners live in the resource, which must outlive the world.
+		 * As with the pmr containers, a copy uses the default resource and an assignment keeps the resource of the world assigned to.
+		 * The resource may be used from the threads of the job system.
+		 */
+		explicit World(std::pmr::memory_resource* resource);
+		World(uint64_t reserveParticleCount, std::pmr::memory_resource* resource);
 		~World();
 		World(const World&) = default;
 		World& operator=(const World&) = default;
 		World(World&& other) noexcept;
+		/// Exchanges the content of the worlds when they share their resource, moves every particle and contact into this one's otherwise.
 		World& operator=(World&& other) noexcept;
 	public:
+		/// The worlds must use the same resource.
 		void swap(World& other) noexcept;
+		[[nodiscard]] std::pmr::memory_resource* GetMemoryResource() const;
 	public:
 		WorldIterator AddParticle();
 		WorldIterator AddParticle(const Particle::Shape& shape);
@@ -85,36 +334,276 @@ namespace FYC {
 
 		WorldIterator find(ID id);
 		[[nodiscard]] uint64_t count() const;
+		/// Number of particles a step has to move, the kinematic ones that are awake.
+		[[nodiscard]] uint64_t CountActiveParticles() const;
+		/// Call the function with every particle, in the order of the iterators.
+		void ForEachParticle(FunctionRef<void(ID id, const Particle& particle)> function) const;
 
 		void RemoveParticle(ID id);
+
+		/**
+		 * Clear the changes of every particle and forget the particles removed, the world as it is becomes the baseline of the next changes.
+		 * The removed particles are only tracked from the first call.
+		 */
+		void ClearChanges();
+		/// Call the function with every particle changed since the last ClearChanges, see Particle::GetChanges.
+		void ForEachChangedParticle(FunctionRef<void(ID id, const Particle& particle)> function) const;
+		/// Particles removed since the last ClearChanges, in the order they were. A particle may have been set again with the same ID since.
+		[[nodiscard]] std::span<const ID> GetRemovedParticles() const;
+
+		/**
+		 * The buffer of the world, applied before and after every step.
+		 * Callbacks and listeners change the world through it. A step stage recording into it declares writing
+		 * StepResource::Commands, jobs record into their own buffers and apply them with ApplyCommands.
+		 */
+		[[nodiscard]] CommandBuffer& GetCommandBuffer();
+
+		/**
+		 * Apply the commands of the buffers, as if they were run one buffer after the other, then clear them.
+		 * The commands are sorted by particle and only the last one touching a particle is applied.
+		 * The world must not be stepping, or only run by a stage writing StepResource::Structure.
+		 */
+		void ApplyCommands(std::span<CommandBuffer> buffers);
+		void ApplyCommands(CommandBuffer& buffer);
+
+		/// Capture the particles, the contacts the next step compares against and the warm start impulses.
+		[[nodiscard]] Snapshot TakeSnapshot() const;
+
+		/**
+		 * Put the world back in the state of the snapshot, which must come from this world or a copy of it.
+		 * The particles added since are removed and the ones removed are brought back with their ID.
+		 * The user data, the listeners, the step graph and the settings are left as they are, the pending commands are dropped.
+		 * The world must not be stepping.
+		 */
+		void Restore(const Snapshot& snapshot);
 	public:
-		void SetCallback(ID, Callback);
-		void RemoveCallback(ID);
-		void RemoveAllCallback();
+		/**
+		 * Send the contacts of the particle to the listener after every step, batched with the ones of its other particles.
+		 * A particle has at most one listener, removing the particle stops listening to it. The world only keeps a pointer
+		 * to the listener, it must be removed before being destroyed, and must not add or remove listeners from OnCollisions.
+		 */
+		void Listen(ID id, CollisionListener& listener);
+		void StopListening(ID id);
+		void RemoveCollisionListener(const CollisionListener& listener);
+		void RemoveAllCollisionListeners();
+
+		/// Call the function with every contact the particle had during the last step, without allocating.
+		void ForEachCollision(ID id, FunctionRef<void(ID otherId, const Collision& collision)> function) const;
+
+		/**
+		 * Listen to the contacts starting, lasting and ending in the world.
+		 * Every step the listener is called once with the events it asked for, sorted by type (Persist, Begin, End) then by pair.
+		 * The contacts are only tracked while the world has listeners, Persist events are only made if one asks for them.
+		 * A listener must not add or remove listeners.
+		 * @param listener Called with the events of a step, not called when there is none
+		 * @param filter The events the listener receives
+		 */
+		ContactListenerHandle AddContactListener(ContactListener listener, ContactEventFilter filter = {});
+		void RemoveContactListener(ContactListenerHandle handle);
+		void RemoveAllContactListeners();
+
+		/**
+		 * Listen to the kinematic particles entering and leaving the sensors.
+		 * Every step the listener is called once with the Begin events then the End events, each sorted by sensor then particle.
+		 * The overlaps are only tested while the world has sensor listeners. A listener must not add or remove listeners.
+		 * @param listener Called with the events of a step, not called when there is none
+		 */
+		SensorListenerHandle AddSensorListener(SensorListener listener);
+		void RemoveSensorListener(SensorListenerHandle handle);
+		void RemoveAllSensorListeners();
+	private:
+		struct ContactListenerEntry {
+			ContactListener Listener;
+			ContactEventFilter Filter;
+		};
+
+		/// A contact between two particles, the pair is ordered.
+		using PairCollision = std::pair<std::pair<ID, ID>, Collision>;
+
+		/// Contact of a particle during the step.
+		struct FrameCollision {
+			ID Id;
+			ID OtherId;
+			/// Position of the record in the step, the last record of a pair is the one kept.
+			uint32_t Order;
+			Collision Contact;
+		};
+
+		struct PendingCommand {
+			ID Id;
+			/// Position of the command across the applied buffers.
+			uint32_t Order;
+			CommandBuffer::CommandType Type;
+			Particle* Body;
+		};
+
+		struct CollisionListenerEntry {
+			CollisionListener* Listener;
+			uint64_t ParticleCount;
+			std::pmr::vector<CollisionRecord> Records;
+		};
 	private:
-		void FindParticlesCollisions();
+		void UpdatePeakMemoryStats();
+		[[nodiscard]] static Snapshot::ParticleState CaptureParticleState(ID id, const Particle& particle);
+		static void RestoreParticleState(const Snapshot::ParticleState& state, Particle& particle);
+		void FindParticlesCollisions(Real speculativeTime = 0);
+		[[nodiscard]] static Collision CollideParticles(const Particle& a, const Particle& b, Real speculativeTime);
+		[[nodiscard]] static bool OverlapParticles(const Particle& a, const Particle& b);
+		void BuildBroadphasePairs(Real stepTime);
 		void ResolveParticleCollisions(Real stepTime);
+		void BuildVelocityConstraints(Real stepTime, bool addAllParticles = false);
+		void ColorVelocityConstraints();
+		void WarmStartVelocityConstraints();
+		[[nodiscard]] Real SolveVelocityConstraint(SolverContact& contact, bool accumulateImpulses);
+		[[nodiscard]] Real SolveVelocityConstraintBatch(uint32_t begin, uint32_t end, bool accumulateImpulses, bool parallel);
+		void SolveVelocityConstraints(Real stepTime);
+		void StoreSolverContacts(bool cacheImpulses);
+		void IntegrateSubstep(Real substepTime);
+		void ProjectPositionConstraints(Real substepTime);
+		void UpdateSubstepVelocities(Real substepTime);
 		void FindAndResolveBoundsCollisions(Real stepTime);
+		void AddFrameCollision(ID id, ID otherId, const Collision& collision);
+		void SortFrameCollisions();
 
+		void GatherBulletPairs();
+		[[nodiscard]] Vec2 SweepBullet(ID id, const Particle& bullet, const SweptMotion& motion, FunctionRef<SweptMotion(const Particle& obstacle)> getObstacleMotion) const;
 		void Integrate(Real stepTime);
-		void PutParticlesToSleep(Real stepTime);
+		void IntegratePositions(Real stepTime);
+		void IntegrateVelocities(Real stepTime);
+		void ClearAccelerations();
+		void EvaluateSleep(Real stepTime);
+		void PutParticlesToSleep();
 		void DragParticles();
 
 		void InvokeCollisionsCallbacks();
+		void DispatchContactEvents();
+		void FindSensorOverlaps();
+		void DispatchSensorEvents();
 
+		void StepIterative(Real stepTime);
+		void StepSpeculative(Real stepTime);
+		void StepSubstepped(Real stepTime);
+		void StepSolver(Real stepTime);
+		void StepSubsteps(Real stepTime);
+		[[nodiscard]] static StepGraph CreateStepGraph();
+		void PrepareParallelStep();
+		void ParallelFor(uint32_t count, uint32_t grainSize, JobSystem::RangeJob job);
+		[[nodiscard]] bool IsOverBudget() const;
 	public:
 		void Step(Real stepTime);
+
+		/**
+		 * Step the world, giving up quality instead of time once the budget is spent.
+		 * The solver is cut short, then the sleep checks and the warm starting cache are skipped.
+		 * The contacts are always solved at least once, and the collision callbacks are always called,
+		 * so the step may still run over a budget that is too small. GetStepStatistics reports what was degraded.
+		 * @param stepTime The simulated time
+		 * @param budget The wall-clock time the step should take at most
+		 */
+		void Step(Real stepTime, Clock::duration budget);
+
+		/**
+		 * Step the world in several smaller steps, for stability, without paying the whole pipeline each time.
+		 * The broadphase pairs are found once with bounds fattened by the movement of the frame, every substep only runs
+		 * the narrowphase on them and the solver. The particles are put to sleep and dragged once,
+		 * and the callbacks are called once with the contacts of every substep.
+		 * @param stepTime The simulated time of the whole step
+		 * @param substeps The number of substeps, each simulating stepTime / substeps
+		 * @param budget The wall-clock time the step should take at most, the remaining substeps are merged past it
+		 */
+		void Step(Real stepTime, uint32_t substeps, Clock::duration budget = Clock::duration::max());
+		[[nodiscard]] const StepStatistics& GetStepStatistics() const;
+
+		/**
+		 * Bytes the world holds right now, estimated from the layout of the usual standard library containers.
+		 * The heap storage of the listener functions can't be seen and isn't counted, nor is the user data
+		 * unless measured: std::any can't tell the size of what it holds.
+		 */
+		[[nodiscard]] MemoryStats GetMemoryStats() const;
+		/// @param userDataSize Bytes a particle user data holds outside of the particle, called for every particle holding some.
+		[[nodiscard]] MemoryStats GetMemoryStats(FunctionRef<uint64_t(const std::any& data)> userDataSize) const;
+		/// Most bytes every part held at the end of a step, the user data left out. Growing peaks point to unbounded growth.
+		[[nodiscard]] const MemoryStats& GetPeakMemoryStats() const;
+		/// Most bytes the world held at the end of a step, the parts may peak at different steps so it isn't the sum of their peaks.
+		[[nodiscard]] uint64_t GetPeakTotalMemory() const;
+
+		/**
+		 * The stages a step runs after the particles of the step are gathered.
+		 * The built-in ones are "Solve", "ClearAccelerations", "EvaluateSleep", "Sleep", "Drag", "Sensors", "Callbacks",
+		 * "ContactEvents" and "SensorEvents".
+		 * Stages can be inserted among them, they run on the thread calling Step or on the job system.
+		 */
+		[[nodiscard]] StepGraph& GetStepGraph();
+		[[nodiscard]] const StepGraph& GetStepGraph() const;
 	public:
 		[[nodiscard]] WorldIterator begin() {return WorldIterator{*this, m_Particles.empty() ? NULL_ID : m_Particles.begin()->first};}
 		[[nodiscard]] WorldIterator end() {return WorldIterator{*this, NULL_ID};}
 	private:
-		std::unordered_map<ID, Particle> m_Particles;
-		std::unordered_map<std::pair<ID, ID>, Collision, PairHasher> m_Collisions;
-		std::unordered_map<ID, Callback> m_CollisionCallbacks;
-		std::unordered_map<ID, std::unordered_map<ID, Collision>> m_TotalFrameCollisions;
+		/// The other containers are created with the allocator of m_Particles, so they all follow the pmr rules for copies and moves alike.
+		std::pmr::unordered_map<ID, Particle> m_Particles;
+		/// The contacts of the current detection pass, sorted by pair.
+		std::pmr::vector<PairCollision> m_Collisions{m_Particles.get_allocator()};
+		CommandBuffer m_CommandBuffer{m_Particles.get_allocator().resource()};
+		std::pmr::vector<PendingCommand> m_PendingCommands{m_Particles.get_allocator()};
+		std::pmr::vector<CollisionListenerEntry> m_CollisionListeners{m_Particles.get_allocator()};
+		/// Index in m_CollisionListeners of the listener of every listened particle.
+		std::pmr::unordered_map<ID, uint32_t> m_ListenedParticles{m_Particles.get_allocator()};
+		bool m_InvokingCollisionListeners = false;
+		std::pmr::map<ContactListenerHandle, ContactListenerEntry> m_ContactListeners{m_Particles.get_allocator()};
+		ContactListenerHandle m_ContactListenerHandleGenerator{0};
+		/// The contacts of the last step sorted by pair, to tell the new contacts from the lasting ones.
+		std::pmr::vector<PairCollision> m_ActiveContacts{m_Particles.get_allocator()};
+		std::pmr::vector<PairCollision> m_StepContacts{m_Particles.get_allocator()};
+		std::pmr::vector<ContactEvent> m_ContactEvents{m_Particles.get_allocator()};
+		std::pmr::vector<ContactEvent> m_FilteredContactEvents{m_Particles.get_allocator()};
+		std::pmr::map<SensorListenerHandle, SensorListener> m_SensorListeners{m_Particles.get_allocator()};
+		SensorListenerHandle m_SensorListenerHandleGenerator{0};
+		/// The (sensor, particle) overlaps of the last step, sorted, to tell the new overlaps from the lasting ones.
+		std::pmr::vector<std::pair<ID, ID>> m_ActiveSensorOverlaps{m_Particles.get_allocator()};
+		std::pmr::vector<std::pair<ID, ID>> m_StepSensorOverlaps{m_Particles.get_allocator()};
+		std::pmr::vector<std::pmr::vector<ID>> m_SensorChunkOverlaps{m_Particles.get_allocator()};
+		std::pmr::vector<SensorEvent> m_SensorEvents{m_Particles.get_allocator()};
+		/// The contacts of the step both ways, the bounds (NULL_ID) only on the particle side. Sorted by particle once solved.
+		std::pmr::vector<FrameCollision> m_TotalFrameCollisions{m_Particles.get_allocator()};
+		/// Impulses of the last step sorted by pair, to warm start the solver.
+		std::pmr::vector<std::pair<std::pair<ID, ID>, Real>> m_ContactImpulses{m_Particles.get_allocator()};
+		std::pmr::vector<SolverBody> m_SolverBodies{m_Particles.get_allocator()};
+		std::pmr::vector<SolverContact> m_SolverContacts{m_Particles.get_allocator()};
+		std::pmr::vector<SolverContact> m_SolverContactsScratch{m_Particles.get_allocator()};
+		std::pmr::vector<uint32_t> m_SolverBatchOffsets{m_Particles.get_allocator()};
+		std::pmr::vector<Real> m_SolverChunkResiduals{m_Particles.get_allocator()};
+		std::shared_ptr<JobSystem> m_JobSystem;
+		/// The particles of the current step, indexable so the phases can be cut in chunks.
+		std::pmr::vector<std::pair<ID, Particle*>> m_StepParticles{m_Particles.get_allocator()};
+		/// The sensors of the current step sorted by ID, left out of m_StepParticles so the solver never sees them.
+		std::pmr::vector<std::pair<ID, Particle*>> m_StepSensors{m_Particles.get_allocator()};
+		std::pmr::vector<std::pmr::vector<PairCollision>> m_ChunkCollisions{m_Particles.get_allocator()};
+		std::pmr::vector<std::pair<Particle*, Vec2>> m_BulletMovements{m_Particles.get_allocator()};
+		/// The contacts the iterative solver resolved in its current pass, and the latest contact of every pair over its passes.
+		std::pmr::vector<PairCollision> m_ResolvedCollisions{m_Particles.get_allocator()};
+		std::pmr::vector<PairCollision> m_IterativeCollisions{m_Particles.get_allocator()};
+		std::pmr::vector<PairCollision> m_IterativeCollisionsScratch{m_Particles.get_allocator()};
+		std::pmr::vector<std::pmr::vector<BroadphasePair>> m_ChunkBroadphasePairs{m_Particles.get_allocator()};
+		std::pmr::vector<BroadphaseBox> m_BroadphaseBoxes{m_Particles.get_allocator()};
+		std::pmr::vector<BroadphasePair> m_BroadphasePairs{m_Particles.get_allocator()};
+		/// The broadphase pairs of every bullet, from the bullet side and sorted by bullet.
+		std::pmr::vector<BroadphasePair> m_BulletPairs{m_Particles.get_allocator()};
+		bool m_UseBroadphasePairs = false;
 		ID m_IDGenerator{0ull};
+		/// Particles removed since the last ClearChanges, once it was called.
+		std::pmr::vector<ID> m_RemovedParticles{m_Particles.get_allocator()};
+		bool m_TracksChanges = false;
+		StepGraph m_StepGraph = CreateStepGraph();
+		uint32_t m_StepSubsteps = 1;
+		/// Particles of the step, by index, the sleep evaluation decided to put to sleep.
+		std::pmr::vector<uint8_t> m_SleepRequests{m_Particles.get_allocator()};
+		StepStatistics m_StepStatistics;
+		MemoryStats m_PeakMemoryStats;
+		uint64_t m_PeakTotalMemory = 0;
+		Clock::time_point m_StepDeadline = Clock::time_point::max();
 	public:
 		std::variant<std::monostate, AABB> Bounds;
+		SolverSettings Solver;
 	};
 
 	static_assert(std::forward_iterator<World::WorldIterator>);
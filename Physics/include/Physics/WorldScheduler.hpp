@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Physics/Math.hpp"
+#include "Physics/World.hpp"
+
+namespace FYC {
+
+	/**
+	 * Steps many independent worlds at once on a fixed set of threads.
+	 * A world is always stepped by a single thread, so its result is the same as a serial World::Step.
+	 * Worlds can be pinned to a thread, the others are spread every step by their number of active particles.
+	 * The scheduler doesn't own the worlds, they must outlive it or be removed, and must not be touched while a step runs.
+	 */
+	class WorldScheduler
+	{
+	public:
+		using WorldHandle = uint32_t;
+		inline static constexpr uint32_t NoAffinity = ~0u;
+	public:
+		/**
+		 * @param threadCount Number of threads stepping the worlds, the calling thread doesn't step any.
+		 */
+		explicit WorldScheduler(uint32_t threadCount);
+		~WorldScheduler();
+		WorldScheduler(const WorldScheduler&) = delete;
+		WorldScheduler& operator=(const WorldScheduler&) = delete;
+	public:
+		/**
+		 * @param world The world to step, it isn't owned by the scheduler
+		 * @param affinity The thread that steps this world, or NoAffinity to let the scheduler balance it
+		 */
+		WorldHandle AddWorld(World& world, uint32_t affinity = NoAffinity);
+		void RemoveWorld(WorldHandle handle);
+		void SetAffinity(WorldHandle handle, uint32_t affinity);
+
+		[[nodiscard]] uint32_t GetThreadCount() const;
+		[[nodiscard]] uint64_t GetWorldCount() const;
+	public:
+		/**
+		 * Start stepping every world, and return right away. Waits for the previous step first.
+		 * @return A future ready once every world is stepped, it rethrows the first exception a World::Step threw
+		 */
+		std::shared_future<void> StepAsync(Real stepTime, uint32_t substeps = 1);
+
+		/// Barrier: wait until every world of the last StepAsync is stepped.
+		void Wait();
+
+		/// StepAsync and Wait.
+		void Step(Real stepTime, uint32_t substeps = 1);
+	private:
+		struct ScheduledWorld {
+			World* Target;
+			uint32_t Affinity;
+		};
+	private:
+		void AssignWorlds();
+		void WorkerLoop(uint32_t thread);
+	private:
+		std::map<WorldHandle, ScheduledWorld> m_Worlds;
+		std::vector<std::vector<World*>> m_Assignments;
+		WorldHandle m_HandleGenerator{0};
+
+		std::vector<std::thread> m_Workers;
+		std::mutex m_Mutex;
+		std::condition_variable m_WorkAvailable;
+		uint64_t m_Generation = 0;
+		bool m_Stopping = false;
+
+		Real m_StepTime{0};
+		uint32_t m_Substeps = 1;
+		std::atomic<uint32_t> m_PendingThreads{0};
+		std::exception_ptr m_Exception;
+		std::promise<void> m_Promise;
+		std::shared_future<void> m_Future;
+	};
+
+} // FYC
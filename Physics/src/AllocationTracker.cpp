@@ -0,0 +1,69 @@
+#include "Physics/AllocationTracker.hpp"
+
+#ifdef FYC_TRACK_ALLOCATIONS
+
+namespace {
+	std::atomic<uint64_t> s_AllocationCount{0};
+}
+
+// The array and nothrow forms of new forward to these ones.
+void* operator new(const std::size_t size) {
+	s_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+	if (void* pointer = std::malloc(size ? size : 1)) return pointer;
+	throw std::bad_alloc();
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment) {
+	s_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+	const auto align = static_cast<std::size_t>(alignment);
+	// aligned_alloc wants a size multiple of the alignment.
+	if (void* pointer = std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align)) return pointer;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+	std::free(pointer);
+}
+
+// The array and sized forms are replaced as well so every delete of the program frees with the functions above.
+void operator delete[](void* pointer) noexcept {
+	operator delete(pointer);
+}
+
+void operator delete[](void* pointer, const std::align_val_t alignment) noexcept {
+	operator delete(pointer, alignment);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+	operator delete(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+	operator delete(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, const std::align_val_t alignment) noexcept {
+	operator delete(pointer, alignment);
+}
+
+void operator delete[](void* pointer, std::size_t, const std::align_val_t alignment) noexcept {
+	operator delete(pointer, alignment);
+}
+
+#endif
+
+namespace FYC {
+
+	uint64_t GetAllocationCount() {
+#ifdef FYC_TRACK_ALLOCATIONS
+		return s_AllocationCount.load(std::memory_order_relaxed);
+#else
+		return 0;
+#endif
+	}
+
+} // FYC
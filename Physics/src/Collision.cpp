@@ -7,13 +7,75 @@
 using namespace FYC::Literal;
 
 namespace FYC {
-	Collision CollisionDetector::Collide(const Circle &a, const Circle &b)
+	static const TimeOfImpact NoImpact{{0,0}, 1, false};
+
+	// Shapes already touching only hit if the movement pushes them further into each other.
+	static TimeOfImpact StartingImpact(const Vec2& collisionNormal, const Vec2& movement)
+	{
+		return {collisionNormal, 0, Math::Dot(collisionNormal, movement) < 0};
+	}
+
+	// Ray starting at 'origin' going along 'movement' against a circle.
+	static TimeOfImpact SweepPoint(const Vec2& origin, const Vec2& movement, const Vec2& center, const Real radius)
+	{
+		const Vec2 centerToOrigin = origin - center;
+		const Real reach = radius + Math::Magnitude(movement);
+		const Real distanceSqr = Math::MagnitudeSqr(centerToOrigin);
+		if (distanceSqr > reach * reach) return NoImpact;
+
+		const Real alignment = Math::Dot(centerToOrigin, movement);
+		if (alignment >= 0) return NoImpact;
+
+		const Real movementSqr = Math::MagnitudeSqr(movement);
+		const Real discriminant = alignment * alignment - movementSqr * (distanceSqr - radius * radius);
+		if (discriminant < 0) return NoImpact;
+
+		const Real time = std::max(0_r, (-alignment - Math::Sqrt(discriminant)) / movementSqr);
+		if (time > 1) return NoImpact;
+
+		const Vec2 normal = origin + movement * time - center;
+		const Real lenNormal = Math::Magnitude(normal);
+		if (lenNormal <= REAL_EPSILON) return {-Math::Normalize(movement), time, true};
+		return {normal / lenNormal, time, true};
+	}
+
+	// Ray starting at 'origin' going along 'movement' against an AABB, using the slab method.
+	static TimeOfImpact SweepPoint(const Vec2& origin, const Vec2& movement, const AABB& box)
+	{
+		Real entry = -REAL_MAX;
+		Real exit = REAL_MAX;
+		Vec2 normal{};
+
+		for (unsigned int axis = 0; axis < 2; ++axis) {
+			if (Math::Abs(movement[axis]) <= REAL_EPSILON) {
+				if (origin[axis] < box.Min[axis] || origin[axis] > box.Max[axis]) return NoImpact;
+				continue;
+			}
+
+			const Real timeMin = (box.Min[axis] - origin[axis]) / movement[axis];
+			const Real timeMax = (box.Max[axis] - origin[axis]) / movement[axis];
+			const Real timeNear = std::min(timeMin, timeMax);
+			const Real timeFar = std::max(timeMin, timeMax);
+
+			if (timeNear > entry) {
+				entry = timeNear;
+				normal = {};
+				normal[axis] = -Math::Sign(movement[axis]);
+			}
+			exit = std::min(exit, timeFar);
+		}
+
+		if (entry > exit || entry > 1 || exit < 0) return NoImpact;
+		return {normal, std::max(0_r, entry), true};
+	}
+
+	Collision CollisionDetector::Collide(const Circle &a, const Circle &b, const Real margin)
 	{
 		const Real sumRadii = a.Radius + b.Radius;
 		const Vec2 aToB = b.Position - a.Position;
 		const Real lenAToB = Math::Magnitude(aToB);
 
-		if (lenAToB > sumRadii) return {{0,0}, {0,0}, 0, false};
+		if (lenAToB > sumRadii + margin) return {{0,0}, {0,0}, 0, false};
 
 		if (lenAToB <= REAL_EPSILON) {
 			return {a.Position, {0,1}, sumRadii, true};
@@ -23,12 +85,12 @@ namespace FYC {
 		return {a.Position + aToB + (collisionNormal * (sumRadii * 0.5f)), collisionNormal, sumRadii - lenAToB, true};
 	}
 
-	Collision CollisionDetector::Collide(const AABB &a, const AABB &b) {
+	Collision CollisionDetector::Collide(const AABB &a, const AABB &b, const Real margin) {
 		const Vec2 maxSize = a.GetHalfSize() + b.GetHalfSize();
 		const Vec2 aToB = b.GetCenter() - a.GetCenter();
-		const Vec2 absAToB = {std::abs(aToB.x), std::abs(aToB.y)};
+		const Vec2 absAToB = {Math::Abs(aToB.x), Math::Abs(aToB.y)};
 
-		if (absAToB.x > maxSize.x || absAToB.y > maxSize.y) return {{0,0}, {0,0}, 0, false};
+		if (absAToB.x > maxSize.x + margin || absAToB.y > maxSize.y + margin) return {{0,0}, {0,0}, 0, false};
 
 		Vec2 distanceToMove = maxSize - absAToB;
 		Real interpenetration = std::min(distanceToMove.x, distanceToMove.y);
@@ -46,12 +108,12 @@ namespace FYC {
 		return {point, normal, interpenetration, true};
 	}
 
-	Collision CollisionDetector::Collide(const Circle &a, const AABB &b) {
+	Collision CollisionDetector::Collide(const Circle &a, const AABB &b, const Real margin) {
 		const Vec2 closestPointToAABB = Vec2{Math::Clamp(a.Position.x, b.Min.x, b.Max.x), Math::Clamp(a.Position.y, b.Min.y, b.Max.y)};
 		const Vec2 aToClosest = closestPointToAABB - a.Position;
 		const Real lenAToClosest = Math::Magnitude(aToClosest);
 
-		if (lenAToClosest > a.Radius) return {{0,0}, {0,0}, 0, false};
+		if (lenAToClosest > a.Radius + margin) return {{0,0}, {0,0}, 0, false};
 
 		if (lenAToClosest > REAL_EPSILON) { // Center is outside the AABB
 			const Vec2 normal = -aToClosest / lenAToClosest;
@@ -60,7 +122,7 @@ namespace FYC {
 			return {pointCollision, normal, inter, true};
 		} else { // Center is inside the AABB
 			const Vec2 aToB = b.GetCenter() - a.Position;
-			const Vec2 absAToB = {std::abs(aToB.x), std::abs(aToB.y)};
+			const Vec2 absAToB = {Math::Abs(aToB.x), Math::Abs(aToB.y)};
 			const Vec2 hf = b.GetHalfSize();
 			const Vec2 distanceToOut = hf - absAToB;
 			const Vec2 normal = distanceToOut.x < distanceToOut.y ? Vec2{-Math::Sign(aToB.x),0} : Vec2{0, -Math::Sign(aToB.y)};
@@ -69,9 +131,47 @@ namespace FYC {
 		}
 	}
 
-	Collision CollisionDetector::Collide(const AABB &a, const Circle &b) {
-		Collision invCol = Collide(b,a);
+	Collision CollisionDetector::Collide(const AABB &a, const Circle &b, const Real margin) {
+		Collision invCol = Collide(b,a,margin);
 		invCol.CollisionNormal *= -1;
 		return invCol;
 	}
-} // FYC
\ No newline at end of file
+
+	TimeOfImpact CollisionDetector::Sweep(const Circle &a, const Vec2 &movement, const Circle &b)
+	{
+		if (const Collision collision = Collide(a, b)) return StartingImpact(collision.CollisionNormal, movement);
+		return SweepPoint(a.Position, movement, b.Position, a.Radius + b.Radius);
+	}
+
+	TimeOfImpact CollisionDetector::Sweep(const AABB &a, const Vec2 &movement, const AABB &b)
+	{
+		if (const Collision collision = Collide(a, b)) return StartingImpact(collision.CollisionNormal, movement);
+		const Vec2 halfSize = a.GetHalfSize();
+		return SweepPoint(a.GetCenter(), movement, AABB{b.Min - halfSize, b.Max + halfSize});
+	}
+
+	TimeOfImpact CollisionDetector::Sweep(const Circle &a, const Vec2 &movement, const AABB &b)
+	{
+		if (const Collision collision = Collide(a, b)) return StartingImpact(collision.CollisionNormal, movement);
+
+		// The Minkowski sum of a circle and an AABB is a rounded box: sweep the box grown by the radius,
+		// and if the hit lands in one of the corners sweep the rounded corner instead.
+		const TimeOfImpact impact = SweepPoint(a.Position, movement, AABB{b.Min - a.Radius, b.Max + a.Radius});
+		if (!impact) return impact;
+
+		const Vec2 point = a.Position + movement * impact.Time;
+		const bool outsideX = point.x < b.Min.x || point.x > b.Max.x;
+		const bool outsideY = point.y < b.Min.y || point.y > b.Max.y;
+		if (!outsideX || !outsideY) return impact;
+
+		const Vec2 corner{point.x < b.Min.x ? b.Min.x : b.Max.x, point.y < b.Min.y ? b.Min.y : b.Max.y};
+		return SweepPoint(a.Position, movement, corner, a.Radius);
+	}
+
+	TimeOfImpact CollisionDetector::Sweep(const AABB &a, const Vec2 &movement, const Circle &b)
+	{
+		TimeOfImpact invImpact = Sweep(b, -movement, a);
+		invImpact.CollisionNormal *= -1;
+		return invImpact;
+	}
+} // FYC
@@ -0,0 +1,90 @@
+#include "Physics/Fixed.hpp"
+
+namespace FYC {
+
+	// The trigonometric polynomial is evaluated with more fractional bits than the storage to limit the rounding errors.
+	static constexpr int TrigFractionalBits = 28;
+	static constexpr Fixed::RawType TrigOne = Fixed::RawType(1) << TrigFractionalBits;
+
+	static constexpr Fixed::RawType ToTrigRaw(const long double value) { return static_cast<Fixed::RawType>(value * TrigOne + 0.5l); }
+	static constexpr Fixed::RawType TrigMultiply(const Fixed::RawType a, const Fixed::RawType b) { return (a * b + (TrigOne >> 1)) >> TrigFractionalBits; }
+
+	static constexpr Fixed::RawType TrigPi = ToTrigRaw(3.14159265358979323846l);
+	static constexpr Fixed::RawType TrigHalfPi = ToTrigRaw(1.57079632679489661923l);
+	static constexpr Fixed::RawType TrigTau = ToTrigRaw(6.28318530717958647692l);
+
+	// Taylor coefficients of sin(x) up to x^11, enough to stay under the storage precision on [-pi/2, pi/2].
+	static constexpr Fixed::RawType SinCoefficients[] {
+		ToTrigRaw(1.0l),
+		-ToTrigRaw(1.0l / 6.0l),
+		ToTrigRaw(1.0l / 120.0l),
+		-ToTrigRaw(1.0l / 5040.0l),
+		ToTrigRaw(1.0l / 362880.0l),
+		-ToTrigRaw(1.0l / 39916800.0l),
+	};
+
+	static uint64_t IntegerSqrt(uint64_t value)
+	{
+		uint64_t result = 0;
+		uint64_t bit = uint64_t(1) << 62;
+		while (bit > value) bit >>= 2;
+		while (bit != 0) {
+			if (value >= result + bit) {
+				value -= result + bit;
+				result = (result >> 1) + bit;
+			} else {
+				result >>= 1;
+			}
+			bit >>= 2;
+		}
+		return result;
+	}
+
+	Fixed Fixed::Abs(const Fixed value)
+	{
+		return value.Raw < 0 ? -value : value;
+	}
+
+	Fixed Fixed::Sqrt(const Fixed value)
+	{
+		if (value.Raw <= 0) return FromRaw(0);
+		const auto raw = static_cast<uint64_t>(value.Raw);
+
+		// sqrt(raw / One) * One == sqrt(raw * One). Fall back to a coarser result when raw * One would overflow.
+		if (raw < (uint64_t(1) << (63 - FractionalBits))) {
+			return FromRaw(static_cast<RawType>(IntegerSqrt(raw << FractionalBits)));
+		}
+		return FromRaw(static_cast<RawType>(IntegerSqrt(raw) << (FractionalBits / 2)));
+	}
+
+	Fixed Fixed::Sin(const Fixed radian)
+	{
+		// Range reduction to [-pi, pi]. Huge angles are first reduced on the storage precision to avoid overflowing.
+		constexpr int shift = TrigFractionalBits - FractionalBits;
+		constexpr RawType storageTau = TrigTau >> shift;
+		RawType angle = radian.Raw;
+		if (angle >= (RawType(1) << (62 - shift)) || angle <= -(RawType(1) << (62 - shift))) angle %= storageTau;
+		angle = (angle << shift) % TrigTau;
+		if (angle > TrigPi) angle -= TrigTau;
+		else if (angle < -TrigPi) angle += TrigTau;
+
+		// sin(pi - x) == sin(x), bring everything to [-pi/2, pi/2] where the polynomial converges quickly.
+		if (angle > TrigHalfPi) angle = TrigPi - angle;
+		else if (angle < -TrigHalfPi) angle = -TrigPi - angle;
+
+		const RawType angleSqr = TrigMultiply(angle, angle);
+		RawType polynomial = SinCoefficients[std::size(SinCoefficients) - 1];
+		for (auto i = static_cast<int64_t>(std::size(SinCoefficients)) - 2; i >= 0; --i) {
+			polynomial = SinCoefficients[i] + TrigMultiply(polynomial, angleSqr);
+		}
+		const RawType result = TrigMultiply(polynomial, angle);
+		return FromRaw((result + (RawType(1) << (shift - 1))) >> shift);
+	}
+
+	Fixed Fixed::Cos(const Fixed radian)
+	{
+		constexpr RawType storageHalfPi = (TrigHalfPi + (RawType(1) << (TrigFractionalBits - FractionalBits - 1))) >> (TrigFractionalBits - FractionalBits);
+		return Sin(FromRaw(radian.Raw + storageHalfPi));
+	}
+
+} // FYC
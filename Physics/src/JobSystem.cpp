@@ -0,0 +1,150 @@
+#include "Physics/JobSystem.hpp"
+
+namespace FYC {
+
+	static constexpr uint64_t PackChunks(const uint32_t begin, const uint32_t end) { return static_cast<uint64_t>(begin) << 32 | end; }
+	static constexpr uint32_t ChunksBegin(const uint64_t chunks) { return static_cast<uint32_t>(chunks >> 32); }
+	static constexpr uint32_t ChunksEnd(const uint64_t chunks) { return static_cast<uint32_t>(chunks); }
+
+	/// Whether the current thread is running a chunk, the loops it starts then run serially.
+	static thread_local bool s_IsRunningChunk = false;
+
+	JobSystem::JobSystem(const uint32_t threadCount) : m_Queues(std::make_unique<ChunkQueue[]>(std::max(1u, threadCount)))
+	{
+		const uint32_t workerCount = threadCount > 1 ? threadCount - 1 : 0;
+		m_Workers.reserve(workerCount);
+		for (uint32_t i = 0; i < workerCount; ++i) {
+			m_Workers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+		}
+	}
+
+	JobSystem::~JobSystem()
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Stopping = true;
+		}
+		m_WorkAvailable.notify_all();
+		for (std::thread& worker : m_Workers) worker.join();
+	}
+
+	uint32_t JobSystem::GetThreadCount() const
+	{
+		return static_cast<uint32_t>(m_Workers.size()) + 1;
+	}
+
+	uint32_t JobSystem::GetChunkCount(const uint32_t count, const uint32_t grainSize)
+	{
+		const uint32_t grain = std::max(1u, grainSize);
+		return (count + grain - 1) / grain;
+	}
+
+	void JobSystem::ParallelFor(const uint32_t count, const uint32_t grainSize, const RangeJob job)
+	{
+		const uint32_t chunkCount = GetChunkCount(count, grainSize);
+		if (m_Workers.empty() || chunkCount <= 1 || s_IsRunningChunk) {
+			const uint32_t grain = std::max(1u, grainSize);
+			for (uint32_t begin = 0; begin < count; begin += grain) job(begin, std::min(count, begin + grain));
+			return;
+		}
+
+		// Only one loop at a time, the job system may be shared by copied worlds.
+		std::lock_guard dispatchLock(m_DispatchMutex);
+		{
+			// Workers still looking for chunks of the previous loop must leave before the queues are refilled.
+			std::unique_lock lock(m_Mutex);
+			m_WorkersIdle.wait(lock, [this]() { return m_ActiveWorkers == 0; });
+
+			m_Job = &job;
+			m_Count = count;
+			m_GrainSize = std::max(1u, grainSize);
+			m_RemainingChunks = chunkCount;
+			const uint32_t threadCount = GetThreadCount();
+			for (uint32_t thread = 0; thread < threadCount; ++thread) {
+				const auto begin = static_cast<uint32_t>(static_cast<uint64_t>(chunkCount) * thread / threadCount);
+				const auto end = static_cast<uint32_t>(static_cast<uint64_t>(chunkCount) * (thread + 1) / threadCount);
+				m_Queues[thread].Chunks = PackChunks(begin, end);
+			}
+			++m_Generation;
+		}
+		m_WorkAvailable.notify_all();
+
+		RunChunks(0);
+		while (m_RemainingChunks.load() != 0) std::this_thread::yield();
+	}
+
+	void JobSystem::WorkerLoop(const uint32_t thread)
+	{
+		uint64_t generation = 0;
+		while (true) {
+			{
+				std::unique_lock lock(m_Mutex);
+				m_WorkAvailable.wait(lock, [this, generation]() { return m_Stopping || m_Generation != generation; });
+				if (m_Stopping) return;
+				generation = m_Generation;
+				++m_ActiveWorkers;
+			}
+
+			RunChunks(thread);
+
+			bool lastWorker;
+			{
+				std::lock_guard lock(m_Mutex);
+				lastWorker = --m_ActiveWorkers == 0;
+			}
+			if (lastWorker) m_WorkersIdle.notify_all();
+		}
+	}
+
+	void JobSystem::RunChunks(const uint32_t thread)
+	{
+		uint32_t chunk;
+		while (PopChunk(thread, chunk) || StealChunk(thread, chunk)) {
+			RunChunk(chunk);
+			m_RemainingChunks.fetch_sub(1);
+		}
+	}
+
+	bool JobSystem::PopChunk(const uint32_t thread, uint32_t& chunk)
+	{
+		std::atomic<uint64_t>& chunks = m_Queues[thread].Chunks;
+		uint64_t current = chunks.load();
+		while (ChunksBegin(current) < ChunksEnd(current)) {
+			if (chunks.compare_exchange_weak(current, PackChunks(ChunksBegin(current) + 1, ChunksEnd(current)))) {
+				chunk = ChunksBegin(current);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool JobSystem::StealChunk(const uint32_t thread, uint32_t& chunk)
+	{
+		const uint32_t threadCount = GetThreadCount();
+		for (uint32_t offset = 1; offset < threadCount; ++offset) {
+			std::atomic<uint64_t>& victim = m_Queues[(thread + offset) % threadCount].Chunks;
+			uint64_t current = victim.load();
+			while (ChunksBegin(current) < ChunksEnd(current)) {
+				// Take the back half, run its first chunk now and keep the others in our own, empty, queue.
+				const uint32_t begin = ChunksBegin(current);
+				const uint32_t end = ChunksEnd(current);
+				const uint32_t middle = begin + (end - begin) / 2;
+				if (victim.compare_exchange_weak(current, PackChunks(begin, middle))) {
+					chunk = middle;
+					m_Queues[thread].Chunks = PackChunks(middle + 1, end);
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	void JobSystem::RunChunk(const uint32_t chunk) const
+	{
+		const uint32_t begin = chunk * m_GrainSize;
+		s_IsRunningChunk = true;
+		(*m_Job)(begin, std::min(m_Count, begin + m_GrainSize));
+		s_IsRunningChunk = false;
+	}
+
+} // FYC
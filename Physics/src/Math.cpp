@@ -15,10 +15,46 @@ namespace FYC
 			return value < 0_r ? -1_r : +1_r;
 		}
 
+		Real Abs(const Real value)
+		{
+#ifdef FYC_FIXED
+			return Fixed::Abs(value);
+#else
+			return std::abs(value);
+#endif
+		}
+
 		Real Clamp(const Real value, const Real min, const Real max) {
 			return std::max(min, std::min(max, value));
 		}
 
+		Real Sqrt(const Real value)
+		{
+#ifdef FYC_FIXED
+			return Fixed::Sqrt(value);
+#else
+			return std::sqrt(value);
+#endif
+		}
+
+		Real Sin(const Real radianAngle)
+		{
+#ifdef FYC_FIXED
+			return Fixed::Sin(radianAngle);
+#else
+			return std::sin(radianAngle);
+#endif
+		}
+
+		Real Cos(const Real radianAngle)
+		{
+#ifdef FYC_FIXED
+			return Fixed::Cos(radianAngle);
+#else
+			return std::cos(radianAngle);
+#endif
+		}
+
 		Real Dot(const Vec2 &a, const Vec2 &b)
 		{
 			return a.x * b.x + a.y * b.y;
@@ -31,7 +67,7 @@ namespace FYC
 
 		Real Magnitude(const Vec2& vec)
 		{
-			return std::sqrt(MagnitudeSqr(vec));
+			return Sqrt(MagnitudeSqr(vec));
 		}
 
 		Vec2 Normalize(const Vec2& vec)
@@ -70,8 +106,8 @@ namespace FYC
 		{
 			return Mat2x2
 			{
-				std::cos(rad), -std::sin(rad),
-				std::sin(rad),  std::cos(rad)
+				Cos(rad), -Sin(rad),
+				Sin(rad),  Cos(rad)
 			};
 		}
 	}
@@ -0,0 +1,152 @@
+#include "Physics/MemoryResource.hpp"
+
+namespace FYC {
+
+	/// Blocks up to 1 MiB are pooled, the buffers of the step find a block of their size again after a clear.
+	/// Few blocks per chunk: the pool grows in small steps, a small world holds little more than it uses.
+	static constexpr std::size_t PoolLargestBlock{1 << 20};
+	static constexpr std::size_t PoolMaxBlocksPerChunk{4};
+
+	// ========== MemoryCounter ==========
+	void MemoryCounter::Allocate(const std::size_t bytes) {
+		m_Allocations.fetch_add(1, std::memory_order_relaxed);
+		const uint64_t current = m_Bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+		uint64_t peak = m_PeakBytes.load(std::memory_order_relaxed);
+		while (current > peak && !m_PeakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {}
+	}
+
+	void MemoryCounter::Deallocate(const std::size_t bytes) {
+		m_Bytes.fetch_sub(bytes, std::memory_order_relaxed);
+	}
+
+	MemoryUsage MemoryCounter::GetUsage() const {
+		return {m_Bytes.load(std::memory_order_relaxed), m_PeakBytes.load(std::memory_order_relaxed), m_Allocations.load(std::memory_order_relaxed)};
+	}
+
+	void MemoryCounter::ResetPeak() {
+		m_PeakBytes.store(m_Bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+
+	// ========== CountingResource ==========
+	CountingResource::CountingResource(std::pmr::memory_resource* upstream) : m_Upstream(upstream) {}
+
+	MemoryUsage CountingResource::GetUsage() const {
+		return m_Counter.GetUsage();
+	}
+
+	void CountingResource::ResetPeak() {
+		m_Counter.ResetPeak();
+	}
+
+	std::pmr::memory_resource* CountingResource::GetUpstream() const {
+		return m_Upstream;
+	}
+
+	void* CountingResource::do_allocate(const std::size_t bytes, const std::size_t alignment) {
+		void* pointer = m_Upstream->allocate(bytes, alignment);
+		m_Counter.Allocate(bytes);
+		return pointer;
+	}
+
+	void CountingResource::do_deallocate(void* pointer, const std::size_t bytes, const std::size_t alignment) {
+		m_Upstream->deallocate(pointer, bytes, alignment);
+		m_Counter.Deallocate(bytes);
+	}
+
+	bool CountingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+		return this == &other;
+	}
+
+	// ========== PoolResource ==========
+	PoolResource::PoolResource(std::pmr::memory_resource* upstream) :
+		m_Upstream(upstream),
+		m_Pool(std::pmr::pool_options{PoolMaxBlocksPerChunk, PoolLargestBlock}, &m_Upstream)
+	{
+	}
+
+	MemoryUsage PoolResource::GetUsage() const {
+		return m_Counter.GetUsage();
+	}
+
+	MemoryUsage PoolResource::GetUpstreamUsage() const {
+		return m_Upstream.GetUsage();
+	}
+
+	void PoolResource::ResetPeak() {
+		m_Counter.ResetPeak();
+		m_Upstream.ResetPeak();
+	}
+
+	void PoolResource::Release() {
+		m_Pool.release();
+		// Whatever was handed out is gone with the pool.
+		m_Counter.Deallocate(m_Counter.GetUsage().Bytes);
+	}
+
+	void* PoolResource::do_allocate(const std::size_t bytes, const std::size_t alignment) {
+		void* pointer = m_Pool.allocate(bytes, alignment);
+		m_Counter.Allocate(bytes);
+		return pointer;
+	}
+
+	void PoolResource::do_deallocate(void* pointer, const std::size_t bytes, const std::size_t alignment) {
+		m_Pool.deallocate(pointer, bytes, alignment);
+		m_Counter.Deallocate(bytes);
+	}
+
+	bool PoolResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+		return this == &other;
+	}
+
+	// ========== MonotonicResource ==========
+	MonotonicResource::MonotonicResource(const std::size_t initialSize, std::pmr::memory_resource* upstream) :
+		m_Upstream(upstream),
+		m_Buffer(initialSize, &m_Upstream)
+	{
+	}
+
+	MonotonicResource::MonotonicResource(const std::span<std::byte> buffer, std::pmr::memory_resource* upstream) :
+		m_Upstream(upstream),
+		m_Buffer(buffer.data(), buffer.size(), &m_Upstream)
+	{
+	}
+
+	MemoryUsage MonotonicResource::GetUsage() const {
+		return m_Counter.GetUsage();
+	}
+
+	MemoryUsage MonotonicResource::GetUpstreamUsage() const {
+		return m_Upstream.GetUsage();
+	}
+
+	void MonotonicResource::ResetPeak() {
+		m_Counter.ResetPeak();
+		m_Upstream.ResetPeak();
+	}
+
+	void MonotonicResource::Release() {
+		std::lock_guard lock(m_Mutex);
+		m_Buffer.release();
+		m_Counter.Deallocate(m_Counter.GetUsage().Bytes);
+	}
+
+	void* MonotonicResource::do_allocate(const std::size_t bytes, const std::size_t alignment) {
+		void* pointer;
+		{
+			std::lock_guard lock(m_Mutex);
+			pointer = m_Buffer.allocate(bytes, alignment);
+		}
+		m_Counter.Allocate(bytes);
+		return pointer;
+	}
+
+	void MonotonicResource::do_deallocate(void*, const std::size_t bytes, std::size_t) {
+		// A monotonic buffer frees nothing until released, only the count goes down.
+		m_Counter.Deallocate(bytes);
+	}
+
+	bool MonotonicResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+		return this == &other;
+	}
+
+} // FYC
@@ -68,16 +68,19 @@ namespace FYC {
 
 	void Particle::AddConstantAcceleration(const Vec2 &constantAcceleration) {
 		m_ConstantAccelerations += constantAcceleration;
+		m_Changes |= ParticleChange::Accelerations;
 		WakeUp();
 	}
 
 	void Particle::SubConstantAcceleration(const Vec2 &constantAcceleration) {
 		m_ConstantAccelerations -= constantAcceleration;
+		m_Changes |= ParticleChange::Accelerations;
 		WakeUp();
 	}
 
 	void Particle::SetConstantAcceleration(const Vec2 &constantAcceleration) {
 		m_ConstantAccelerations = constantAcceleration;
+		m_Changes |= ParticleChange::Accelerations;
 		WakeUp();
 	}
 
@@ -108,6 +111,7 @@ namespace FYC {
 		else if(AABB* aabb = std::get_if<AABB>(&m_Shape)) {
 			*aabb = AABB::FromCenterSize(position, aabb->GetSize());
 		}
+		m_Changes |= ParticleChange::Position;
 		WakeUp();
 	}
 
@@ -124,26 +128,38 @@ namespace FYC {
 
 	void Particle::SetVelocity(const Vec2 &velocity) {
 		m_Velocity = velocity;
+		m_Changes |= ParticleChange::Velocity;
 		WakeUp();
 	}
 	Vec2 Particle::GetVelocity() const { return m_IsKinematic ? m_Velocity : Vec2{}; }
 
 	void Particle::SetKinematic(const bool isKinematic) {
 		m_IsKinematic = isKinematic;
+		m_Changes |= ParticleChange::State;
 		WakeUp();
 	}
 	bool Particle::IsKinematic() const { return m_IsKinematic; }
 
-	void Particle::SetRebound(const Real rebound) { m_Rebound = rebound; }
+	void Particle::SetBullet(const bool isBullet) { m_IsBullet = isBullet; m_Changes |= ParticleChange::State; }
+	bool Particle::IsBullet() const { return m_IsBullet; }
+
+	void Particle::SetSensor(const bool isSensor) { m_IsSensor = isSensor; m_Changes |= ParticleChange::State; }
+	bool Particle::IsSensor() const { return m_IsSensor; }
+
+	void Particle::SetRebound(const Real rebound) { m_Rebound = rebound; m_Changes |= ParticleChange::Material; }
 	Real Particle::GetRebound() const { return m_Rebound; }
 
-	void Particle::SetDrag(const Real drag) { m_Drag = drag; }
+	void Particle::SetDrag(const Real drag) { m_Drag = drag; m_Changes |= ParticleChange::Material; }
 	Real Particle::GetDrag() const { return m_Drag; }
 
 	bool Particle::IsAwake() const { return m_IsAwake; }
-	void Particle::WakeUp() { m_IsAwake = true; }
-	void Particle::Sleep() { m_IsAwake = false; }
-	void Particle::SetIsAwake(const bool isAwake) { m_IsAwake = isAwake; }
+	// Woken up by every setter and by the accelerations applied each step, only an actual change counts.
+	void Particle::WakeUp() { SetIsAwake(true); }
+	void Particle::Sleep() { SetIsAwake(false); }
+	void Particle::SetIsAwake(const bool isAwake) {
+		if (m_IsAwake != isAwake) m_Changes |= ParticleChange::State;
+		m_IsAwake = isAwake;
+	}
 
 	Real Particle::GetInverseMass() const {
 		return m_IsKinematic ? 1 : 0;
@@ -161,6 +177,10 @@ namespace FYC {
 		std::swap(m_AsleepDuration, other.m_AsleepDuration);
 		std::swap(m_IsKinematic, other.m_IsKinematic);
 		std::swap(m_IsAwake, other.m_IsAwake);
+		std::swap(m_IsBullet, other.m_IsBullet);
+		std::swap(m_IsSensor, other.m_IsSensor);
+		std::swap(m_Changes, other.m_Changes);
+		std::swap(m_SolverBody, other.m_SolverBody);
 	}
 
 	std::optional<Real> Particle::GetCircleRadius() const {
@@ -177,6 +197,7 @@ namespace FYC {
 			Vec2 particlePosition = GetPosition();
 			m_Shape = Circle{particlePosition, radius};
 		}
+		m_Changes |= ParticleChange::Shape;
 		WakeUp();
 	}
 
@@ -184,6 +205,7 @@ namespace FYC {
 	{
 		if (Circle *circle = std::get_if<Circle>(&m_Shape)) {
 			circle->Radius = radius;
+			m_Changes |= ParticleChange::Shape;
 			WakeUp();
 			return true;
 		}
@@ -204,6 +226,7 @@ namespace FYC {
 			const Vec2 particlePosition = GetPosition();
 			m_Shape = AABB::FromCenterSize(particlePosition, size);
 		}
+		m_Changes |= ParticleChange::Shape;
 		WakeUp();
 
 	}
@@ -211,6 +234,7 @@ namespace FYC {
 	bool Particle::TrySetRectangleSize(const Vec2 &size) {
 		if (AABB* aabb = std::get_if<AABB>(&m_Shape)) {
 			*aabb = AABB::FromCenterSize(aabb->GetCenter(), size);
+			m_Changes |= ParticleChange::Shape;
 			WakeUp();
 			return true;
 		}
@@ -0,0 +1,107 @@
+#include "Physics/StepDriver.hpp"
+
+using namespace FYC::Literal;
+
+namespace FYC {
+
+	StepDriver::StepDriver(const Real fixedStepTime, const uint32_t maxStepsPerUpdate) : m_FixedStepTime(fixedStepTime), m_MaxStepsPerUpdate(maxStepsPerUpdate)
+	{
+	}
+
+	StepDriver::~StepDriver() = default;
+
+	uint32_t StepDriver::Update(World& world, const Real elapsedTime, const StepCallback& beforeStep, const StepCallback& afterStep)
+	{
+		m_Accumulator += std::max(0_r, elapsedTime);
+
+		uint32_t stepCount = 0;
+		while (m_Accumulator >= m_FixedStepTime && stepCount < m_MaxStepsPerUpdate) {
+			m_Accumulator -= m_FixedStepTime;
+			++stepCount;
+		}
+
+		// Past the step limit the simulation runs slower than real time instead of spiraling into ever longer frames.
+		if (m_Accumulator >= m_FixedStepTime) {
+			m_DroppedTime += m_Accumulator;
+			m_Accumulator = 0;
+		}
+
+		for (uint32_t step = 0; step < stepCount; ++step) {
+			// Only the state before the last step is needed to interpolate toward the current one.
+			if (step + 1 == stepCount) SavePreviousPositions(world);
+			if (beforeStep) beforeStep(m_FixedStepTime);
+			world.Step(m_FixedStepTime, m_StepBudget);
+			if (afterStep) afterStep(m_FixedStepTime);
+		}
+
+		return stepCount;
+	}
+
+	void StepDriver::Reset()
+	{
+		m_PreviousPositions.clear();
+		m_Accumulator = 0;
+		m_DroppedTime = 0;
+	}
+
+	Real StepDriver::GetAlpha() const
+	{
+		return Math::Clamp(m_Accumulator / m_FixedStepTime, 0, 1);
+	}
+
+	Vec2 StepDriver::GetPreviousPosition(const World::ID id, const Particle& particle) const
+	{
+		const auto it = m_PreviousPositions.find(id);
+		return it == m_PreviousPositions.end() ? particle.GetPosition() : it->second;
+	}
+
+	Vec2 StepDriver::GetInterpolatedPosition(const World::ID id, const Particle& particle) const
+	{
+		const Real alpha = GetAlpha();
+		return GetPreviousPosition(id, particle) * (1_r - alpha) + particle.GetPosition() * alpha;
+	}
+
+	Real StepDriver::GetFixedStepTime() const
+	{
+		return m_FixedStepTime;
+	}
+
+	void StepDriver::SetFixedStepTime(const Real fixedStepTime)
+	{
+		m_FixedStepTime = std::max(fixedStepTime, REAL_EPSILON);
+	}
+
+	uint32_t StepDriver::GetMaxStepsPerUpdate() const
+	{
+		return m_MaxStepsPerUpdate;
+	}
+
+	void StepDriver::SetMaxStepsPerUpdate(const uint32_t maxStepsPerUpdate)
+	{
+		m_MaxStepsPerUpdate = maxStepsPerUpdate;
+	}
+
+	World::Clock::duration StepDriver::GetStepBudget() const
+	{
+		return m_StepBudget;
+	}
+
+	void StepDriver::SetStepBudget(const World::Clock::duration stepBudget)
+	{
+		m_StepBudget = stepBudget;
+	}
+
+	Real StepDriver::GetDroppedTime() const
+	{
+		return m_DroppedTime;
+	}
+
+	void StepDriver::SavePreviousPositions(World& world)
+	{
+		m_PreviousPositions.clear();
+		for (auto it = world.begin(); it != world.end(); ++it) {
+			m_PreviousPositions[it.GetID()] = it->GetPosition();
+		}
+	}
+
+} // FYC
@@ -0,0 +1,85 @@
+#include "Physics/StepGraph.hpp"
+
+namespace FYC {
+
+	bool StepGraph::AddStage(StepStage stage, const std::string& before)
+	{
+		if (HasStage(stage.Name)) return false;
+
+		auto position = m_Stages.cend();
+		if (!before.empty()) {
+			position = FindStage(before);
+			if (position == m_Stages.cend()) return false;
+		}
+		m_Stages.insert(position, std::move(stage));
+		m_IsDirty = true;
+		return true;
+	}
+
+	bool StepGraph::RemoveStage(const std::string& name)
+	{
+		const auto it = FindStage(name);
+		if (it == m_Stages.cend()) return false;
+		m_Stages.erase(it);
+		m_IsDirty = true;
+		return true;
+	}
+
+	bool StepGraph::HasStage(const std::string& name) const
+	{
+		return FindStage(name) != m_Stages.cend();
+	}
+
+	const std::vector<StepStage>& StepGraph::GetStages() const
+	{
+		return m_Stages;
+	}
+
+	const std::vector<std::vector<uint32_t>>& StepGraph::GetWaves()
+	{
+		if (m_IsDirty) BuildWaves();
+		return m_Waves;
+	}
+
+	void StepGraph::Run(World& world, const Real stepTime, JobSystem* jobSystem)
+	{
+		for (const std::vector<uint32_t>& wave : GetWaves()) {
+			if (!jobSystem || wave.size() == 1) {
+				for (const uint32_t stage : wave) m_Stages[stage].Run(world, stepTime);
+				continue;
+			}
+			jobSystem->ParallelFor(static_cast<uint32_t>(wave.size()), 1, [this, &wave, &world, stepTime](const uint32_t begin, const uint32_t end) {
+				for (uint32_t i = begin; i < end; ++i) m_Stages[wave[i]].Run(world, stepTime);
+			});
+		}
+	}
+
+	std::vector<StepStage>::const_iterator StepGraph::FindStage(const std::string& name) const
+	{
+		return std::find_if(m_Stages.cbegin(), m_Stages.cend(), [&name](const StepStage& stage) { return stage.Name == name; });
+	}
+
+	void StepGraph::BuildWaves()
+	{
+		// A stage goes in the wave after the last one of the stages it depends on.
+		std::vector<uint32_t> waveOfStage(m_Stages.size(), 0);
+		uint32_t waveCount = 0;
+		for (uint32_t i = 0; i < m_Stages.size(); ++i) {
+			const StepStage& stage = m_Stages[i];
+			uint32_t wave = 0;
+			for (uint32_t j = 0; j < i; ++j) {
+				const StepStage& previous = m_Stages[j];
+				const bool conflicts = (previous.Writes & (stage.Reads | stage.Writes)) || (stage.Writes & previous.Reads);
+				const bool isAfter = std::find(stage.After.cbegin(), stage.After.cend(), previous.Name) != stage.After.cend();
+				if (conflicts || isAfter) wave = std::max(wave, waveOfStage[j] + 1);
+			}
+			waveOfStage[i] = wave;
+			waveCount = std::max(waveCount, wave + 1);
+		}
+
+		m_Waves.assign(waveCount, {});
+		for (uint32_t i = 0; i < m_Stages.size(); ++i) m_Waves[waveOfStage[i]].push_back(i);
+		m_IsDirty = false;
+	}
+
+} // FYC
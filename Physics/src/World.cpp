@@ -11,6 +11,95 @@ namespace FYC {
 	static constexpr Real NumberOfFrameToRemove{2.5};
 	static constexpr Real EpsilonToBeStill{0.001};
 	static constexpr Real TimeStill{1};
+	static constexpr Real ContinuousCollisionSkin{0.01};
+	static constexpr uint32_t MaxBulletSweeps{3};
+	static constexpr Real PenetrationSlop{0.005};
+	static constexpr Real PenetrationCorrection{0.2};
+	static constexpr uint32_t MaxContactBatches{64};
+	static constexpr uint32_t ParticleGrainSize{256};
+	static constexpr uint32_t PairGrainSize{256};
+	static constexpr uint32_t ExhaustiveNarrowphaseGrainSize{16};
+	static constexpr uint32_t ContactGrainSize{128};
+	static constexpr uint32_t SensorGrainSize{1};
+	static constexpr Real BroadphaseSkin{0.05};
+	static constexpr uint32_t NoSolverBody{~0u};
+
+	/// Entry of a vector sorted by pair holding the pair, or end.
+	template<typename Value>
+	static auto FindPair(const std::pmr::vector<std::pair<std::pair<World::ID, World::ID>, Value>>& sorted, const std::pair<World::ID, World::ID>& pair) {
+		const auto it = std::lower_bound(sorted.cbegin(), sorted.cend(), pair, [](const auto& entry, const auto& key) { return entry.first < key; });
+		return it != sorted.cend() && it->first == pair ? it : sorted.cend();
+	}
+
+	/// Order the contact events are delivered in, Persist first so every filter but Persist and End together is contiguous.
+	static constexpr uint8_t GetContactEventRank(const ContactEventType type) {
+		switch (type) {
+			case ContactEventType::Persist: return 0;
+			case ContactEventType::Begin: return 1;
+			case ContactEventType::End: return 2;
+		}
+		return 2;
+	}
+
+	static Particle::Shape Translate(Particle::Shape shape, const Vec2& offset) {
+		if (Circle* circle = std::get_if<Circle>(&shape)) {
+			circle->Position += offset;
+		} else if (AABB* aabb = std::get_if<AABB>(&shape)) {
+			aabb->Min += offset;
+			aabb->Max += offset;
+		}
+		return shape;
+	}
+
+	template<typename Vector>
+	static uint64_t VectorBytes(const Vector& vector) {
+		return vector.capacity() * sizeof(typename Vector::value_type);
+	}
+
+	template<typename Vector>
+	static uint64_t NestedVectorBytes(const Vector& vector) {
+		uint64_t bytes = VectorBytes(vector);
+		for (const auto& inner : vector) bytes += VectorBytes(inner);
+		return bytes;
+	}
+
+	/// A node holds the value and the link to the next one, the hash of an integer key isn't cached.
+	template<typename Map>
+	static uint64_t HashMapBytes(const Map& map) {
+		return map.bucket_count() * sizeof(void*) + map.size() * (sizeof(typename Map::value_type) + sizeof(void*));
+	}
+
+	/// A node holds the value, the links to its parent and children and its color.
+	template<typename Map>
+	static uint64_t TreeMapBytes(const Map& map) {
+		return map.size() * (sizeof(typename Map::value_type) + 4 * sizeof(void*));
+	}
+
+	// ========== CommandBuffer ==========
+	World::CommandBuffer::CommandBuffer(std::pmr::memory_resource* resource) : m_Commands(resource), m_Particles(resource) {}
+
+	void World::CommandBuffer::AddParticle(Particle particle) {
+		m_Commands.push_back({CommandType::Add, NULL_ID, static_cast<uint32_t>(m_Particles.size())});
+		m_Particles.push_back(std::move(particle));
+	}
+
+	void World::CommandBuffer::SetParticle(Particle particle, const ID id) {
+		m_Commands.push_back({CommandType::Set, id, static_cast<uint32_t>(m_Particles.size())});
+		m_Particles.push_back(std::move(particle));
+	}
+
+	void World::CommandBuffer::RemoveParticle(const ID id) {
+		m_Commands.push_back({CommandType::Remove, id, 0});
+	}
+
+	bool World::CommandBuffer::IsEmpty() const {
+		return m_Commands.empty();
+	}
+
+	void World::CommandBuffer::Clear() {
+		m_Commands.clear();
+		m_Particles.clear();
+	}
 
 	// ========== WorldIterator ==========
 	World::WorldIterator::WorldIterator(World &world, const uint64_t particleId) : m_World(&world), m_ParticleId(particleId) { }
@@ -56,17 +145,21 @@ namespace FYC {
 	}
 
 	// ========== World ==========
-	World::World() {
+	World::World() : World(std::pmr::get_default_resource()) {}
+
+	World::World(const uint64_t reserveParticleCount) : World(reserveParticleCount, std::pmr::get_default_resource()) {}
+
+	World::World(std::pmr::memory_resource* resource) : m_Particles(resource) {
 		m_Particles.reserve(256);
 		m_Collisions.reserve(512);
-		m_CollisionCallbacks.reserve(256);
+		m_ListenedParticles.reserve(256);
 		m_TotalFrameCollisions.reserve(256);
 	}
 
-	World::World(const uint64_t reserveParticleCount) {
+	World::World(const uint64_t reserveParticleCount, std::pmr::memory_resource* resource) : m_Particles(resource) {
 		m_Particles.reserve(reserveParticleCount);
 		m_Collisions.reserve(reserveParticleCount);
-		m_CollisionCallbacks.reserve(reserveParticleCount);
+		m_ListenedParticles.reserve(reserveParticleCount);
 		m_TotalFrameCollisions.reserve(reserveParticleCount);
 	}
 
@@ -75,25 +168,144 @@ namespace FYC {
 	World::World(World &&other) noexcept :
 		m_Particles(std::move(other.m_Particles)),
 		m_Collisions(std::move(other.m_Collisions)),
-		m_CollisionCallbacks(std::move(other.m_CollisionCallbacks)),
+		m_CommandBuffer(std::move(other.m_CommandBuffer)),
+		m_CollisionListeners(std::move(other.m_CollisionListeners)),
+		m_ListenedParticles(std::move(other.m_ListenedParticles)),
+		m_ContactListeners(std::move(other.m_ContactListeners)),
+		m_ContactListenerHandleGenerator(other.m_ContactListenerHandleGenerator),
+		m_ActiveContacts(std::move(other.m_ActiveContacts)),
+		m_SensorListeners(std::move(other.m_SensorListeners)),
+		m_SensorListenerHandleGenerator(other.m_SensorListenerHandleGenerator),
+		m_ActiveSensorOverlaps(std::move(other.m_ActiveSensorOverlaps)),
 		m_TotalFrameCollisions(std::move(other.m_TotalFrameCollisions)),
+		m_ContactImpulses(std::move(other.m_ContactImpulses)),
+		m_JobSystem(std::move(other.m_JobSystem)),
 		m_IDGenerator(std::move(other.m_IDGenerator)),
-		Bounds(std::move(other.Bounds))
+		m_RemovedParticles(std::move(other.m_RemovedParticles)),
+		m_TracksChanges(other.m_TracksChanges),
+		m_StepGraph(std::move(other.m_StepGraph)),
+		m_StepStatistics(std::move(other.m_StepStatistics)),
+		m_PeakMemoryStats(other.m_PeakMemoryStats),
+		m_PeakTotalMemory(other.m_PeakTotalMemory),
+		Bounds(std::move(other.Bounds)),
+		Solver(std::move(other.Solver))
 	{
 	}
 
+	std::pmr::memory_resource* World::GetMemoryResource() const {
+		return m_Particles.get_allocator().resource();
+	}
+
 	World & World::operator=(World&& other) noexcept {
-		swap(other);
+		if (this == &other) return *this;
+		if (m_Particles.get_allocator() == other.m_Particles.get_allocator()) {
+			swap(other);
+			return *this;
+		}
+
+		// The pmr containers keep their resource, the elements are moved one by one into it.
+		m_Particles = std::move(other.m_Particles);
+		m_Collisions = std::move(other.m_Collisions);
+		m_CommandBuffer = std::move(other.m_CommandBuffer);
+		m_PendingCommands = std::move(other.m_PendingCommands);
+		m_CollisionListeners = std::move(other.m_CollisionListeners);
+		m_ListenedParticles = std::move(other.m_ListenedParticles);
+		m_ContactListeners = std::move(other.m_ContactListeners);
+		m_ContactListenerHandleGenerator = std::move(other.m_ContactListenerHandleGenerator);
+		m_ActiveContacts = std::move(other.m_ActiveContacts);
+		m_StepContacts = std::move(other.m_StepContacts);
+		m_ContactEvents = std::move(other.m_ContactEvents);
+		m_FilteredContactEvents = std::move(other.m_FilteredContactEvents);
+		m_SensorListeners = std::move(other.m_SensorListeners);
+		m_SensorListenerHandleGenerator = std::move(other.m_SensorListenerHandleGenerator);
+		m_ActiveSensorOverlaps = std::move(other.m_ActiveSensorOverlaps);
+		m_StepSensorOverlaps = std::move(other.m_StepSensorOverlaps);
+		m_SensorChunkOverlaps = std::move(other.m_SensorChunkOverlaps);
+		m_SensorEvents = std::move(other.m_SensorEvents);
+		m_TotalFrameCollisions = std::move(other.m_TotalFrameCollisions);
+		m_IDGenerator = std::move(other.m_IDGenerator);
+		m_RemovedParticles = std::move(other.m_RemovedParticles);
+		m_TracksChanges = std::move(other.m_TracksChanges);
+		m_ContactImpulses = std::move(other.m_ContactImpulses);
+		m_SolverBodies = std::move(other.m_SolverBodies);
+		m_SolverContacts = std::move(other.m_SolverContacts);
+		m_SolverContactsScratch = std::move(other.m_SolverContactsScratch);
+		m_SolverBatchOffsets = std::move(other.m_SolverBatchOffsets);
+		m_SolverChunkResiduals = std::move(other.m_SolverChunkResiduals);
+		m_JobSystem = std::move(other.m_JobSystem);
+		m_StepParticles = std::move(other.m_StepParticles);
+		m_StepSensors = std::move(other.m_StepSensors);
+		m_ChunkCollisions = std::move(other.m_ChunkCollisions);
+		m_BulletMovements = std::move(other.m_BulletMovements);
+		m_ResolvedCollisions = std::move(other.m_ResolvedCollisions);
+		m_IterativeCollisions = std::move(other.m_IterativeCollisions);
+		m_IterativeCollisionsScratch = std::move(other.m_IterativeCollisionsScratch);
+		m_ChunkBroadphasePairs = std::move(other.m_ChunkBroadphasePairs);
+		m_BroadphaseBoxes = std::move(other.m_BroadphaseBoxes);
+		m_BroadphasePairs = std::move(other.m_BroadphasePairs);
+		m_BulletPairs = std::move(other.m_BulletPairs);
+		m_StepGraph = std::move(other.m_StepGraph);
+		m_StepSubsteps = std::move(other.m_StepSubsteps);
+		m_SleepRequests = std::move(other.m_SleepRequests);
+		m_StepStatistics = std::move(other.m_StepStatistics);
+		m_PeakMemoryStats = std::move(other.m_PeakMemoryStats);
+		m_PeakTotalMemory = other.m_PeakTotalMemory;
+		Bounds = std::move(other.Bounds);
+		Solver = std::move(other.Solver);
 		return *this;
 	}
 
 	void World::swap(World &other) noexcept {
+		// The pmr containers can only exchange their memory when it comes from the same resource.
+		assert(m_Particles.get_allocator() == other.m_Particles.get_allocator());
 		std::swap(m_Particles, other.m_Particles);
 		std::swap(m_Collisions, other.m_Collisions);
-		std::swap(m_CollisionCallbacks, other.m_CollisionCallbacks);
+		std::swap(m_CommandBuffer, other.m_CommandBuffer);
+		std::swap(m_PendingCommands, other.m_PendingCommands);
+		std::swap(m_CollisionListeners, other.m_CollisionListeners);
+		std::swap(m_ListenedParticles, other.m_ListenedParticles);
+		std::swap(m_ContactListeners, other.m_ContactListeners);
+		std::swap(m_ContactListenerHandleGenerator, other.m_ContactListenerHandleGenerator);
+		std::swap(m_ActiveContacts, other.m_ActiveContacts);
+		std::swap(m_StepContacts, other.m_StepContacts);
+		std::swap(m_ContactEvents, other.m_ContactEvents);
+		std::swap(m_FilteredContactEvents, other.m_FilteredContactEvents);
+		std::swap(m_SensorListeners, other.m_SensorListeners);
+		std::swap(m_SensorListenerHandleGenerator, other.m_SensorListenerHandleGenerator);
+		std::swap(m_ActiveSensorOverlaps, other.m_ActiveSensorOverlaps);
+		std::swap(m_StepSensorOverlaps, other.m_StepSensorOverlaps);
+		std::swap(m_SensorChunkOverlaps, other.m_SensorChunkOverlaps);
+		std::swap(m_SensorEvents, other.m_SensorEvents);
 		std::swap(m_TotalFrameCollisions, other.m_TotalFrameCollisions);
 		std::swap(m_IDGenerator, other.m_IDGenerator);
+		std::swap(m_RemovedParticles, other.m_RemovedParticles);
+		std::swap(m_TracksChanges, other.m_TracksChanges);
+		std::swap(m_ContactImpulses, other.m_ContactImpulses);
+		std::swap(m_SolverBodies, other.m_SolverBodies);
+		std::swap(m_SolverContacts, other.m_SolverContacts);
+		std::swap(m_SolverContactsScratch, other.m_SolverContactsScratch);
+		std::swap(m_SolverBatchOffsets, other.m_SolverBatchOffsets);
+		std::swap(m_SolverChunkResiduals, other.m_SolverChunkResiduals);
+		std::swap(m_JobSystem, other.m_JobSystem);
+		std::swap(m_StepParticles, other.m_StepParticles);
+		std::swap(m_StepSensors, other.m_StepSensors);
+		std::swap(m_ChunkCollisions, other.m_ChunkCollisions);
+		std::swap(m_BulletMovements, other.m_BulletMovements);
+		std::swap(m_ResolvedCollisions, other.m_ResolvedCollisions);
+		std::swap(m_IterativeCollisions, other.m_IterativeCollisions);
+		std::swap(m_IterativeCollisionsScratch, other.m_IterativeCollisionsScratch);
+		std::swap(m_ChunkBroadphasePairs, other.m_ChunkBroadphasePairs);
+		std::swap(m_BroadphaseBoxes, other.m_BroadphaseBoxes);
+		std::swap(m_BroadphasePairs, other.m_BroadphasePairs);
+		std::swap(m_BulletPairs, other.m_BulletPairs);
+		std::swap(m_StepGraph, other.m_StepGraph);
+		std::swap(m_StepSubsteps, other.m_StepSubsteps);
+		std::swap(m_SleepRequests, other.m_SleepRequests);
+		std::swap(m_StepStatistics, other.m_StepStatistics);
+		std::swap(m_PeakMemoryStats, other.m_PeakMemoryStats);
+		std::swap(m_PeakTotalMemory, other.m_PeakTotalMemory);
 		std::swap(Bounds, other.Bounds);
+		std::swap(Solver, other.Solver);
 	}
 
 	World::WorldIterator World::AddParticle() {
@@ -122,25 +334,27 @@ namespace FYC {
 
 	World::WorldIterator World::AddParticle(const Particle &particle) {
 		auto id = m_IDGenerator++;
-		m_Particles.insert({id, particle});
+		m_Particles.insert({id, particle}).first->second.m_Changes = ParticleChange::All;
 		return {*this, id};
 	}
 
 	World::WorldIterator World::AddParticle(Particle &&particle) {
 		auto id = m_IDGenerator++;
-		m_Particles.insert({id, std::move(particle)});
+		m_Particles.insert({id, std::move(particle)}).first->second.m_Changes = ParticleChange::All;
 		return {*this, id};
 	}
 
 	World::WorldIterator World::SetParticle(const Particle& particle, const ID id) {
 		m_IDGenerator = std::max(m_IDGenerator, id+1);
-		m_Particles[id] = particle;
+		Particle& stored = m_Particles[id] = particle;
+		stored.m_Changes = ParticleChange::All;
 		return {this, id};
 	}
 
 	World::WorldIterator World::SetParticle(Particle&& particle, ID id) {
 		m_IDGenerator = std::max(m_IDGenerator, id+1);
-		m_Particles[id] = std::move(particle);
+		Particle& stored = m_Particles[id] = std::move(particle);
+		stored.m_Changes = ParticleChange::All;
 		return {this, id};
 	}
 
@@ -169,52 +383,344 @@ namespace FYC {
 		return m_Particles.size();
 	}
 
+	uint64_t World::CountActiveParticles() const {
+		return std::count_if(m_Particles.begin(), m_Particles.end(), [](const auto& pair) { return pair.second.IsKinematic() && pair.second.IsAwake(); });
+	}
+
+	void World::ForEachParticle(const FunctionRef<void(ID id, const Particle& particle)> function) const {
+		for (const auto& [id, particle] : m_Particles) function(id, particle);
+	}
+
 	void World::RemoveParticle(const ID id) {
-		m_Particles.erase(id);
+		StopListening(id);
+		if (m_Particles.erase(id) && m_TracksChanges) m_RemovedParticles.push_back(id);
 	}
 
-	void World::SetCallback(const ID id, Callback func) {
-		m_CollisionCallbacks[id] = std::move(func);
+	void World::ClearChanges() {
+		for (auto& [id, particle] : m_Particles) particle.ClearChanges();
+		m_RemovedParticles.clear();
+		m_TracksChanges = true;
 	}
 
-	void World::RemoveCallback(const ID id) {
-		m_CollisionCallbacks.erase(id);
+	void World::ForEachChangedParticle(const FunctionRef<void(ID id, const Particle& particle)> function) const {
+		for (const auto& [id, particle] : m_Particles) {
+			if (particle.m_Changes != ParticleChange::None) function(id, particle);
+		}
 	}
 
-	void World::RemoveAllCallback() {
-		m_CollisionCallbacks.clear();
+	std::span<const World::ID> World::GetRemovedParticles() const {
+		return m_RemovedParticles;
 	}
 
-	void World::FindParticlesCollisions() {
-		static_assert(std::is_same<Particle::Shape, std::variant<Circle, AABB>>());
+	World::CommandBuffer& World::GetCommandBuffer() {
+		return m_CommandBuffer;
+	}
+
+	void World::ApplyCommands(CommandBuffer& buffer) {
+		ApplyCommands({&buffer, 1});
+	}
+
+	void World::ApplyCommands(const std::span<CommandBuffer> buffers) {
+		// As SetParticle, the set IDs are never given to an added particle, the ones of this batch included.
+		for (const CommandBuffer& buffer : buffers) {
+			for (const CommandBuffer::Command& command : buffer.m_Commands) {
+				if (command.Type == CommandBuffer::CommandType::Set) m_IDGenerator = std::max(m_IDGenerator, command.Id + 1);
+			}
+		}
+
+		// The new particles get their IDs in the order they were queued, the same whatever thread recorded them.
+		m_PendingCommands.clear();
+		uint32_t order = 0;
+		for (CommandBuffer& buffer : buffers) {
+			for (const CommandBuffer::Command& command : buffer.m_Commands) {
+				const ID id = command.Type == CommandBuffer::CommandType::Add ? m_IDGenerator++ : command.Id;
+				Particle* particle = command.Type == CommandBuffer::CommandType::Remove ? nullptr : &buffer.m_Particles[command.ParticleIndex];
+				m_PendingCommands.push_back({id, order++, command.Type, particle});
+			}
+		}
+		if (m_PendingCommands.empty()) return;
+
+		// Adding, setting and removing all replace the particle, only the last command of each one matters.
+		std::sort(m_PendingCommands.begin(), m_PendingCommands.end(), [](const PendingCommand& a, const PendingCommand& b) {
+			return std::tie(a.Id, a.Order) < std::tie(b.Id, b.Order);
+		});
+		for (uint32_t i = 0; i < m_PendingCommands.size(); ++i) {
+			const PendingCommand& command = m_PendingCommands[i];
+			if (i + 1 < m_PendingCommands.size() && m_PendingCommands[i + 1].Id == command.Id) continue;
+			if (command.Type == CommandBuffer::CommandType::Remove) {
+				StopListening(command.Id);
+				if (m_Particles.erase(command.Id) && m_TracksChanges) m_RemovedParticles.push_back(command.Id);
+			} else {
+				m_Particles.insert_or_assign(command.Id, std::move(*command.Body)).first->second.m_Changes = ParticleChange::All;
+			}
+		}
+
+		m_PendingCommands.clear();
+		for (CommandBuffer& buffer : buffers) buffer.Clear();
+	}
+
+	World::Snapshot World::TakeSnapshot() const {
+		Snapshot snapshot;
+		std::vector<Particle> copies;
+		snapshot.m_States.reserve(m_Particles.size());
+		snapshot.m_Indices.reserve(m_Particles.size());
+		copies.reserve(m_Particles.size());
+		for (const auto& [id, particle] : m_Particles) {
+			snapshot.m_Indices.emplace_back(id, static_cast<uint32_t>(snapshot.m_States.size()));
+			snapshot.m_States.push_back(CaptureParticleState(id, particle));
+			copies.push_back(particle);
+		}
+		std::sort(snapshot.m_Indices.begin(), snapshot.m_Indices.end());
+		snapshot.m_Particles = std::make_shared<const std::vector<Particle>>(std::move(copies));
+		snapshot.m_ActiveContacts.assign(m_ActiveContacts.cbegin(), m_ActiveContacts.cend());
+		snapshot.m_ContactImpulses.assign(m_ContactImpulses.cbegin(), m_ContactImpulses.cend());
+		snapshot.m_ActiveSensorOverlaps.assign(m_ActiveSensorOverlaps.cbegin(), m_ActiveSensorOverlaps.cend());
+		snapshot.m_IDGenerator = m_IDGenerator;
+		return snapshot;
+	}
+
+	void World::Restore(const Snapshot& snapshot) {
+		m_CommandBuffer.Clear();
+
+		// As long as no particle was added or removed the particles come in the order of the states, a single pass restores them.
+		auto particle = m_Particles.begin();
+		uint32_t restored = 0;
+		for (; particle != m_Particles.end() && restored < snapshot.m_States.size() && particle->first == snapshot.m_States[restored].Id; ++particle, ++restored) {
+			RestoreParticleState(snapshot.m_States[restored], particle->second);
+		}
+
+		if (particle != m_Particles.end() || restored != snapshot.m_States.size()) {
+			// The particles added since the snapshot are the ones it doesn't know.
+			std::erase_if(m_Particles, [this, &snapshot](const auto& entry) {
+				const bool isAdded = !std::binary_search(snapshot.m_Indices.cbegin(), snapshot.m_Indices.cend(), std::pair{entry.first, 0u}, [](const auto& a, const auto& b) { return a.first < b.first; });
+				if (isAdded && m_TracksChanges) m_RemovedParticles.push_back(entry.first);
+				return isAdded;
+			});
+			for (const auto& [id, index] : snapshot.m_Indices) {
+				auto it = m_Particles.find(id);
+				// Removed since the snapshot, the only particles copied whole.
+				if (it == m_Particles.end()) {
+					it = m_Particles.emplace(id, (*snapshot.m_Particles)[index]).first;
+					it->second.m_Changes = ParticleChange::All;
+				}
+				RestoreParticleState(snapshot.m_States[index], it->second);
+			}
+		}
+
+		m_ActiveContacts.assign(snapshot.m_ActiveContacts.cbegin(), snapshot.m_ActiveContacts.cend());
+		m_ContactImpulses.assign(snapshot.m_ContactImpulses.cbegin(), snapshot.m_ContactImpulses.cend());
+		m_ActiveSensorOverlaps.assign(snapshot.m_ActiveSensorOverlaps.cbegin(), snapshot.m_ActiveSensorOverlaps.cend());
+		m_TotalFrameCollisions.clear();
+		m_IDGenerator = snapshot.m_IDGenerator;
+		m_StepStatistics = {};
+	}
+
+	World::Snapshot::ParticleState World::CaptureParticleState(const ID id, const Particle& particle) {
+		return {
+			id, particle.m_Shape, particle.m_Velocity, particle.m_ConstantAccelerations, particle.m_SummedAccelerations, particle.m_PreviousPosition,
+			particle.m_Rebound, particle.m_Drag, particle.m_AsleepDuration,
+			particle.m_IsKinematic, particle.m_IsAwake, particle.m_IsBullet, particle.m_IsSensor,
+		};
+	}
+
+	void World::RestoreParticleState(const Snapshot::ParticleState& state, Particle& particle) {
+		particle.m_Shape = state.Shape;
+		particle.m_Velocity = state.Velocity;
+		particle.m_ConstantAccelerations = state.ConstantAccelerations;
+		particle.m_SummedAccelerations = state.SummedAccelerations;
+		particle.m_PreviousPosition = state.PreviousPosition;
+		particle.m_Rebound = state.Rebound;
+		particle.m_Drag = state.Drag;
+		particle.m_AsleepDuration = state.AsleepDuration;
+		particle.m_IsKinematic = state.IsKinematic;
+		particle.m_IsAwake = state.IsAwake;
+		particle.m_IsBullet = state.IsBullet;
+		particle.m_IsSensor = state.IsSensor;
+		// Whatever the steps changed since the snapshot is changed back.
+		particle.m_Changes |= ParticleChange::All & ~ParticleChange::Created;
+	}
+
+	void World::Listen(const ID id, CollisionListener& listener) {
+		StopListening(id);
+		auto entry = std::find_if(m_CollisionListeners.begin(), m_CollisionListeners.end(), [&listener](const CollisionListenerEntry& e) { return e.Listener == &listener; });
+		if (entry == m_CollisionListeners.end()) entry = m_CollisionListeners.insert(entry, {&listener, 0, std::pmr::vector<CollisionRecord>{GetMemoryResource()}});
+		++entry->ParticleCount;
+		m_ListenedParticles[id] = static_cast<uint32_t>(entry - m_CollisionListeners.begin());
+	}
+
+	void World::StopListening(const ID id) {
+		const auto it = m_ListenedParticles.find(id);
+		if (it == m_ListenedParticles.end()) return;
+		const uint32_t index = it->second;
+		m_ListenedParticles.erase(it);
+		// A particle removed by a callback leaves its listener in place until every listener was called.
+		if (--m_CollisionListeners[index].ParticleCount == 0 && !m_InvokingCollisionListeners) RemoveCollisionListener(*m_CollisionListeners[index].Listener);
+	}
+
+	void World::RemoveCollisionListener(const CollisionListener& listener) {
+		const auto entry = std::find_if(m_CollisionListeners.begin(), m_CollisionListeners.end(), [&listener](const CollisionListenerEntry& e) { return e.Listener == &listener; });
+		if (entry == m_CollisionListeners.end()) return;
+		const auto index = static_cast<uint32_t>(entry - m_CollisionListeners.begin());
+		m_CollisionListeners.erase(entry);
+		std::erase_if(m_ListenedParticles, [index](const auto& listened) { return listened.second == index; });
+		for (auto& [id, listenerIndex] : m_ListenedParticles) {
+			if (listenerIndex > index) --listenerIndex;
+		}
+	}
+
+	void World::RemoveAllCollisionListeners() {
+		m_CollisionListeners.clear();
+		m_ListenedParticles.clear();
+	}
+
+	void World::ForEachCollision(const ID id, const FunctionRef<void(ID otherId, const Collision& collision)> function) const {
+		auto it = std::lower_bound(m_TotalFrameCollisions.cbegin(), m_TotalFrameCollisions.cend(), id, [](const FrameCollision& collision, const ID value) { return collision.Id < value; });
+		for (; it != m_TotalFrameCollisions.cend() && it->Id == id; ++it) function(it->OtherId, it->Contact);
+	}
+
+	World::ContactListenerHandle World::AddContactListener(ContactListener listener, const ContactEventFilter filter) {
+		const ContactListenerHandle handle = m_ContactListenerHandleGenerator++;
+		m_ContactListeners[handle] = {std::move(listener), filter};
+		return handle;
+	}
+
+	void World::RemoveContactListener(const ContactListenerHandle handle) {
+		m_ContactListeners.erase(handle);
+	}
+
+	void World::RemoveAllContactListeners() {
+		m_ContactListeners.clear();
+	}
+
+	World::SensorListenerHandle World::AddSensorListener(SensorListener listener) {
+		const SensorListenerHandle handle = m_SensorListenerHandleGenerator++;
+		m_SensorListeners[handle] = std::move(listener);
+		return handle;
+	}
+
+	void World::RemoveSensorListener(const SensorListenerHandle handle) {
+		m_SensorListeners.erase(handle);
+	}
+
+	void World::RemoveAllSensorListeners() {
+		m_SensorListeners.clear();
+	}
+
+	void World::FindParticlesCollisions(const Real speculativeTime) {
 		m_Collisions.clear();
-		for (auto it = begin(); it != end(); ++it) {
-			auto nextIt = it;
-			++nextIt;
-			for ( ;nextIt != end(); ++nextIt) {
-				Collision collision;
-				auto a = it.GetID() < nextIt.GetID() ? it : nextIt;
-				auto b = it.GetID() < nextIt.GetID() ? nextIt : it;
-
-				if ((!a->IsKinematic() || !a->IsAwake()) && (!b->IsKinematic() || !b->IsAwake())) continue;
-
-				{
-					Circle ca, cb;
-					AABB ra, rb;
-					if (a->HasShape<Circle>(ca) && b->HasShape<Circle>(cb)) collision = CollisionDetector::Collide(ca,cb);
-					else if (a->HasShape<AABB>(ra) && b->HasShape<AABB>(rb)) collision = CollisionDetector::Collide(ra,rb);
-					else if (a->HasShape<AABB>(ra) && b->HasShape<Circle>(cb)) collision = CollisionDetector::Collide(ra,cb);
-					else if (a->HasShape<Circle>(ca) && b->HasShape<AABB>(rb)) collision = CollisionDetector::Collide(ca,rb);
+		++m_StepStatistics.DetectionPasses;
+
+		// Every chunk keeps its own contacts, merged in chunk order so the result doesn't depend on the threads.
+		const auto count = static_cast<uint32_t>(m_UseBroadphasePairs ? m_BroadphasePairs.size() : m_StepParticles.size());
+		const uint32_t grainSize = m_UseBroadphasePairs ? PairGrainSize : ExhaustiveNarrowphaseGrainSize;
+		m_ChunkCollisions.resize(JobSystem::GetChunkCount(count, grainSize));
+		for (auto& chunkCollisions : m_ChunkCollisions) chunkCollisions.clear();
+
+		ParallelFor(count, grainSize, [this, speculativeTime, grainSize](const uint32_t begin, const uint32_t end) {
+			auto& chunkCollisions = m_ChunkCollisions[begin / grainSize];
+			if (m_UseBroadphasePairs) {
+				for (uint32_t i = begin; i < end; ++i) {
+					const BroadphasePair& pair = m_BroadphasePairs[i];
+					if (const Collision collision = CollideParticles(*pair.BodyA, *pair.BodyB, speculativeTime)) {
+						chunkCollisions.push_back({{pair.IdA, pair.IdB}, collision});
+					}
 				}
+				return;
+			}
 
-				if (collision) {
-					m_Collisions[{a.GetID(), b.GetID()}] = collision;
+			for (uint32_t i = begin; i < end; ++i) {
+				for (uint32_t j = i + 1; j < m_StepParticles.size(); ++j) {
+					const auto& a = m_StepParticles[i].first < m_StepParticles[j].first ? m_StepParticles[i] : m_StepParticles[j];
+					const auto& b = m_StepParticles[i].first < m_StepParticles[j].first ? m_StepParticles[j] : m_StepParticles[i];
+					if (const Collision collision = CollideParticles(*a.second, *b.second, speculativeTime)) {
+						chunkCollisions.push_back({{a.first, b.first}, collision});
+					}
 				}
 			}
+		});
+
+		for (const auto& chunkCollisions : m_ChunkCollisions) {
+			m_Collisions.insert(m_Collisions.end(), chunkCollisions.begin(), chunkCollisions.end());
 		}
+		// Sorted by pair, the solvers run in the same order whatever the threads and the broadphase.
+		std::sort(m_Collisions.begin(), m_Collisions.end(), [](const PairCollision& a, const PairCollision& b) { return a.first < b.first; });
+	}
+
+	Collision World::CollideParticles(const Particle& a, const Particle& b, const Real speculativeTime) {
+		static_assert(std::is_same<Particle::Shape, std::variant<Circle, AABB>>());
+		if ((!a.IsKinematic() || !a.IsAwake()) && (!b.IsKinematic() || !b.IsAwake())) return {};
+
+		// Speculative contacts are reported as long as the particles can reach each other during the step.
+		const Real margin = speculativeTime > 0 ? Math::Magnitude(a.GetVelocity() - b.GetVelocity()) * speculativeTime : 0_r;
+
+		Circle ca, cb;
+		AABB ra, rb;
+		if (a.HasShape<Circle>(ca) && b.HasShape<Circle>(cb)) return CollisionDetector::Collide(ca,cb,margin);
+		if (a.HasShape<AABB>(ra) && b.HasShape<AABB>(rb)) return CollisionDetector::Collide(ra,rb,margin);
+		if (a.HasShape<AABB>(ra) && b.HasShape<Circle>(cb)) return CollisionDetector::Collide(ra,cb,margin);
+		if (a.HasShape<Circle>(ca) && b.HasShape<AABB>(rb)) return CollisionDetector::Collide(ca,rb,margin);
+		return {};
+	}
+
+	bool World::OverlapParticles(const Particle& a, const Particle& b) {
+		return std::visit([](const auto& shapeA, const auto& shapeB) {
+			return static_cast<bool>(CollisionDetector::Collide(shapeA, shapeB));
+		}, a.m_Shape, b.m_Shape);
+	}
+
+	void World::BuildBroadphasePairs(const Real stepTime) {
+		static_assert(std::is_same<Particle::Shape, std::variant<Circle, AABB>>());
+		m_BroadphasePairs.clear();
+
+		// Every bound is fattened by how far the particle may move during the frame, the pairs stay valid for all its substeps.
+		m_BroadphaseBoxes.resize(m_StepParticles.size());
+		ParallelFor(static_cast<uint32_t>(m_StepParticles.size()), ParticleGrainSize, [this, stepTime](const uint32_t begin, const uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				const auto [id, particle] = m_StepParticles[i];
+				AABB bounds;
+				if (const Circle* circle = std::get_if<Circle>(&particle->m_Shape)) bounds = AABB::FromCenterHalfSize(circle->Position, Vec2{circle->Radius});
+				else if (const AABB* aabb = std::get_if<AABB>(&particle->m_Shape)) bounds = *aabb;
+
+				if (particle->IsKinematic()) {
+					const Real acceleration = Math::Magnitude(particle->m_ConstantAccelerations + particle->m_SummedAccelerations);
+					const Real margin = (Math::Magnitude(particle->m_Velocity) + acceleration * stepTime) * stepTime + BroadphaseSkin;
+					bounds.Min -= Vec2{margin};
+					bounds.Max += Vec2{margin};
+				}
+				m_BroadphaseBoxes[i] = {bounds, id, particle};
+			}
+		});
+
+		// Sweep and prune along x, the ID breaks the ties so the pairs don't depend on the hash map order.
+		std::sort(m_BroadphaseBoxes.begin(), m_BroadphaseBoxes.end(), [](const BroadphaseBox& a, const BroadphaseBox& b) {
+			return a.Bounds.Min.x < b.Bounds.Min.x || (a.Bounds.Min.x == b.Bounds.Min.x && a.Id < b.Id);
+		});
+
+		const auto boxCount = static_cast<uint32_t>(m_BroadphaseBoxes.size());
+		m_ChunkBroadphasePairs.resize(JobSystem::GetChunkCount(boxCount, ParticleGrainSize));
+		for (auto& chunkPairs : m_ChunkBroadphasePairs) chunkPairs.clear();
+		ParallelFor(boxCount, ParticleGrainSize, [this, boxCount](const uint32_t begin, const uint32_t end) {
+			auto& chunkPairs = m_ChunkBroadphasePairs[begin / ParticleGrainSize];
+			for (uint32_t i = begin; i < end; ++i) {
+				const BroadphaseBox& boxA = m_BroadphaseBoxes[i];
+				for (uint32_t j = i + 1; j < boxCount && m_BroadphaseBoxes[j].Bounds.Min.x <= boxA.Bounds.Max.x; ++j) {
+					const BroadphaseBox& boxB = m_BroadphaseBoxes[j];
+					if (boxA.Bounds.Max.y < boxB.Bounds.Min.y || boxB.Bounds.Max.y < boxA.Bounds.Min.y) continue;
+					// Sleeping particles keep their pairs, they may be woken up by an earlier substep.
+					if (!boxA.Body->IsKinematic() && !boxB.Body->IsKinematic()) continue;
+					if (boxA.Id < boxB.Id) chunkPairs.push_back({boxA.Id, boxA.Body, boxB.Id, boxB.Body});
+					else chunkPairs.push_back({boxB.Id, boxB.Body, boxA.Id, boxA.Body});
+				}
+			}
+		});
+		for (const auto& chunkPairs : m_ChunkBroadphasePairs) {
+			m_BroadphasePairs.insert(m_BroadphasePairs.end(), chunkPairs.begin(), chunkPairs.end());
+		}
+		m_StepStatistics.BroadphasePairs += m_BroadphasePairs.size();
 	}
 
 	void World::ResolveParticleCollisions(Real stepTime) {
+		m_ResolvedCollisions.clear();
 		for (const auto& [pair, collision] : m_Collisions)
 		{
 			Particle* particleA = GetParticle(pair.first);
@@ -257,9 +763,6 @@ namespace FYC {
 
 				particleA->SetVelocity(velA + directedSeparatedImpulseA * inverseMassA);
 				particleB->SetVelocity(velB - directedSeparatedImpulseB * inverseMassB);
-
-				m_TotalFrameCollisions[pair.first][pair.second] = collision;
-				m_TotalFrameCollisions[pair.second][pair.first] = collision;
 			}
 
 			// Resolving Interpenetration
@@ -271,10 +774,296 @@ namespace FYC {
 
 				particleA->SetPosition(posA + separatingMovement * inverseMassA);
 				particleB->SetPosition(posB - separatingMovement * inverseMassB);
+			}
+
+			if (contactVelocity <= 0 || collision.Interpenetration > 0) m_ResolvedCollisions.emplace_back(pair, collision);
+		}
+
+		// Both lists are sorted by pair, the contact of this pass replaces the one of the previous passes.
+		m_IterativeCollisionsScratch.clear();
+		std::set_union(m_ResolvedCollisions.cbegin(), m_ResolvedCollisions.cend(), m_IterativeCollisions.cbegin(), m_IterativeCollisions.cend(),
+			std::back_inserter(m_IterativeCollisionsScratch), [](const PairCollision& a, const PairCollision& b) { return a.first < b.first; });
+		std::swap(m_IterativeCollisions, m_IterativeCollisionsScratch);
+	}
+
+	void World::BuildVelocityConstraints(const Real stepTime, const bool addAllParticles) {
+		m_SolverBodies.clear();
+		m_SolverContacts.clear();
+
+		// The particles remember their body, no lookup table is built.
+		for (const auto& [id, particle] : m_StepParticles) particle->m_SolverBody = NoSolverBody;
+		const auto getBodyIndex = [this](Particle* particle) {
+			// Sleeping particles didn't look for their own contacts, they hold still for this step and are woken up if pushed.
+			if (particle->m_SolverBody == NoSolverBody) {
+				particle->m_SolverBody = static_cast<uint32_t>(m_SolverBodies.size());
+				const Vec2 position = particle->GetPosition();
+				const Vec2 acceleration = particle->m_ConstantAccelerations + particle->m_SummedAccelerations;
+				m_SolverBodies.push_back({particle, particle->GetVelocity(), particle->IsAwake() ? particle->GetInverseMass() : 0_r, 0, position, position, acceleration});
+			}
+			return particle->m_SolverBody;
+		};
+
+		// The position solver integrates the particles itself, including the ones touching nothing.
+		if (addAllParticles) {
+			for (const auto& [id, particle] : m_StepParticles) {
+				if (particle->IsKinematic() && particle->IsAwake()) getBodyIndex(particle);
+			}
+		}
+
+		// The collisions are sorted by pair, so are the contacts.
+		for (const auto& [pair, collision] : m_Collisions) {
+			Particle* particleA = GetParticle(pair.first);
+			Particle* particleB = GetParticle(pair.second);
+			if (!particleA || !particleB) continue;
+
+			const uint32_t bodyA = getBodyIndex(particleA);
+			const uint32_t bodyB = getBodyIndex(particleB);
+			const Real inverseMassA = m_SolverBodies[bodyA].InverseMass;
+			const Real inverseMassB = m_SolverBodies[bodyB].InverseMass;
+			const Real totalInverseMass = inverseMassA + inverseMassB;
+			if (totalInverseMass <= REAL_EPSILON) continue;
+
+			Real targetVelocity;
+			if (collision.Interpenetration < 0) {
+				// Not touching yet: the particles may close the gap during the step, but no more.
+				targetVelocity = collision.Interpenetration / stepTime;
+			} else {
+				// Touching: bounce, without the velocity the constant accelerations built up, and push out of the penetration.
+				const Real contactVelocity = Math::Dot(collision.CollisionNormal, particleA->GetVelocity() - particleB->GetVelocity());
+				Real accCausedSepVelocity = Math::Dot(collision.CollisionNormal, particleA->GetConstantAccelerations() - particleB->GetConstantAccelerations()) * stepTime * NumberOfFrameToRemove;
+				if (accCausedSepVelocity > 0) accCausedSepVelocity = 0;
+				const Real separatingVelocity = std::max(0_r, -contactVelocity + accCausedSepVelocity);
+				const Real rebound = (particleA->GetRebound() * inverseMassA + particleB->GetRebound() * inverseMassB) / totalInverseMass;
+				const Real penetrationVelocity = std::max(0_r, collision.Interpenetration - PenetrationSlop) * PenetrationCorrection / stepTime;
+				targetVelocity = std::max(separatingVelocity * rebound, penetrationVelocity);
+			}
+
+			m_SolverContacts.push_back({pair, bodyA, bodyB, collision, 1_r / totalInverseMass, targetVelocity, 0, 0, false});
+		}
+		m_StepStatistics.ContactCount += m_SolverContacts.size();
+	}
+
+	void World::ColorVelocityConstraints() {
+		// Greedy coloring: a contact goes in the first batch that doesn't move any of its particles yet,
+		// so the contacts of a batch can be solved in any order, or at the same time.
+		// Static and sleeping particles are only read and can be shared. The contacts that don't fit in any batch
+		// go in a last one that is solved sequentially.
+		std::array<uint32_t, MaxContactBatches + 1> batchSizes{};
+		for (SolverContact& contact : m_SolverContacts) {
+			SolverBody& bodyA = m_SolverBodies[contact.BodyA];
+			SolverBody& bodyB = m_SolverBodies[contact.BodyB];
+			uint64_t usedBatches = 0;
+			if (bodyA.InverseMass > 0) usedBatches |= bodyA.Batches;
+			if (bodyB.InverseMass > 0) usedBatches |= bodyB.Batches;
+
+			contact.Batch = static_cast<uint32_t>(std::countr_one(usedBatches));
+			if (contact.Batch < MaxContactBatches) {
+				const uint64_t batchBit = 1ull << contact.Batch;
+				if (bodyA.InverseMass > 0) bodyA.Batches |= batchBit;
+				if (bodyB.InverseMass > 0) bodyB.Batches |= batchBit;
+			}
+			++batchSizes[contact.Batch];
+		}
+
+		m_SolverBatchOffsets.assign(batchSizes.size() + 1, 0);
+		for (uint32_t batch = 0; batch < batchSizes.size(); ++batch) {
+			m_SolverBatchOffsets[batch + 1] = m_SolverBatchOffsets[batch] + batchSizes[batch];
+			if (batchSizes[batch] > 0) ++m_StepStatistics.ContactBatches;
+		}
+
+		// Stable scatter, the contacts of a batch keep their sorted order.
+		m_SolverContactsScratch.resize(m_SolverContacts.size());
+		std::array<uint32_t, MaxContactBatches + 1> cursors;
+		std::copy_n(m_SolverBatchOffsets.begin(), cursors.size(), cursors.begin());
+		for (const SolverContact& contact : m_SolverContacts) {
+			m_SolverContactsScratch[cursors[contact.Batch]++] = contact;
+		}
+		std::swap(m_SolverContacts, m_SolverContactsScratch);
+	}
+
+	void World::WarmStartVelocityConstraints() {
+		for (SolverContact& contact : m_SolverContacts) {
+			const auto it = FindPair(m_ContactImpulses, contact.Key);
+			if (it == m_ContactImpulses.cend()) continue;
+			contact.Impulse = it->second;
+			SolverBody& bodyA = m_SolverBodies[contact.BodyA];
+			SolverBody& bodyB = m_SolverBodies[contact.BodyB];
+			const Vec2 directedImpulse = contact.Contact.CollisionNormal * contact.Impulse;
+			bodyA.Velocity += directedImpulse * bodyA.InverseMass;
+			bodyB.Velocity -= directedImpulse * bodyB.InverseMass;
+		}
+	}
+
+	Real World::SolveVelocityConstraint(SolverContact& contact, const bool accumulateImpulses) {
+		SolverBody& bodyA = m_SolverBodies[contact.BodyA];
+		SolverBody& bodyB = m_SolverBodies[contact.BodyB];
+		const Real contactVelocity = Math::Dot(contact.Contact.CollisionNormal, bodyA.Velocity - bodyB.Velocity);
+		const Real lambda = (contact.TargetVelocity - contactVelocity) * contact.NormalMass;
+
+		// Accumulated impulses may be reduced as long as the total keeps pushing the particles apart.
+		Real impulse;
+		if (accumulateImpulses) {
+			const Real accumulated = std::max(0_r, contact.Impulse + lambda);
+			impulse = accumulated - contact.Impulse;
+			contact.Impulse = accumulated;
+		} else {
+			impulse = std::max(0_r, lambda);
+			contact.Impulse += impulse;
+		}
+
+		// Particles that can't move may be shared by the contacts solved in parallel, never write them.
+		const Vec2 directedImpulse = contact.Contact.CollisionNormal * impulse;
+		if (bodyA.InverseMass > 0) bodyA.Velocity += directedImpulse * bodyA.InverseMass;
+		if (bodyB.InverseMass > 0) bodyB.Velocity -= directedImpulse * bodyB.InverseMass;
+		return Math::Abs(impulse) / contact.NormalMass;
+	}
+
+	Real World::SolveVelocityConstraintBatch(const uint32_t begin, const uint32_t end, const bool accumulateImpulses, const bool parallel) {
+		if (!parallel || !m_JobSystem || end - begin <= ContactGrainSize) {
+			Real residual = 0;
+			for (uint32_t i = begin; i < end; ++i) {
+				residual = std::max(residual, SolveVelocityConstraint(m_SolverContacts[i], accumulateImpulses));
+			}
+			return residual;
+		}
+
+		m_SolverChunkResiduals.assign(JobSystem::GetChunkCount(end - begin, ContactGrainSize), 0);
+		m_JobSystem->ParallelFor(end - begin, ContactGrainSize, [this, begin, accumulateImpulses](const uint32_t chunkBegin, const uint32_t chunkEnd) {
+			Real residual = 0;
+			for (uint32_t i = begin + chunkBegin; i < begin + chunkEnd; ++i) {
+				residual = std::max(residual, SolveVelocityConstraint(m_SolverContacts[i], accumulateImpulses));
+			}
+			m_SolverChunkResiduals[chunkBegin / ContactGrainSize] = residual;
+		});
+		return *std::max_element(m_SolverChunkResiduals.begin(), m_SolverChunkResiduals.end());
+	}
+
+	void World::SolveVelocityConstraints(const Real stepTime) {
+		const bool accumulateImpulses = Solver.Type == SolverType::SequentialImpulse;
+
+		BuildVelocityConstraints(stepTime);
+		ColorVelocityConstraints();
+		if (accumulateImpulses && Solver.WarmStarting) WarmStartVelocityConstraints();
+
+		for (uint32_t iteration = 0; iteration < Solver.Iterations; ++iteration) {
+			if (iteration > 0 && IsOverBudget()) {
+				m_StepStatistics.SolverIterationsCut = true;
+				break;
+			}
+			++m_StepStatistics.SolverIterations;
+			Real residual = 0;
+			for (uint32_t batch = 0; batch + 1 < m_SolverBatchOffsets.size(); ++batch) {
+				const bool parallel = batch < MaxContactBatches;
+				residual = std::max(residual, SolveVelocityConstraintBatch(m_SolverBatchOffsets[batch], m_SolverBatchOffsets[batch + 1], accumulateImpulses, parallel));
+			}
+			if (residual <= Solver.Tolerance) break;
+		}
+
+		for (const SolverBody& body : m_SolverBodies) {
+			if (body.InverseMass > 0) body.Body->SetVelocity(body.Velocity);
+		}
+
+		StoreSolverContacts(accumulateImpulses);
+	}
 
-				m_TotalFrameCollisions[pair.first][pair.second] = collision;
-				m_TotalFrameCollisions[pair.second][pair.first] = collision;
+	void World::StoreSolverContacts(bool cacheImpulses) {
+		if (cacheImpulses && IsOverBudget()) {
+			m_StepStatistics.WarmStartSkipped = true;
+			cacheImpulses = false;
+		}
+		m_ContactImpulses.clear();
+		for (const SolverContact& contact : m_SolverContacts) {
+			if (contact.Impulse > 0) {
+				if (m_SolverBodies[contact.BodyA].Body->IsKinematic()) m_SolverBodies[contact.BodyA].Body->WakeUp();
+				if (m_SolverBodies[contact.BodyB].Body->IsKinematic()) m_SolverBodies[contact.BodyB].Body->WakeUp();
 			}
+			if (contact.Impulse <= 0 && contact.Contact.Interpenetration < 0) continue;
+			if (cacheImpulses) m_ContactImpulses.emplace_back(contact.Key, contact.Impulse);
+			AddFrameCollision(contact.Key.first, contact.Key.second, contact.Contact);
+		}
+		// The contacts were scattered by batch.
+		std::sort(m_ContactImpulses.begin(), m_ContactImpulses.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+	}
+
+	void World::IntegrateSubstep(const Real substepTime) {
+		for (SolverBody& body : m_SolverBodies) {
+			if (body.InverseMass <= 0) continue;
+			body.PreviousPosition = body.Position;
+			body.Velocity += body.Acceleration * substepTime;
+			body.Position += body.Velocity * substepTime;
+		}
+
+		// Bullets are swept every substep, against the other bodies moving over the same substep.
+		const auto getObstacleMotion = [this](const Particle& obstacle) {
+			if (obstacle.m_SolverBody == NoSolverBody) return SweptMotion{};
+			const SolverBody& body = m_SolverBodies[obstacle.m_SolverBody];
+			return SweptMotion{body.PreviousPosition - obstacle.GetPosition(), body.Position - body.PreviousPosition};
+		};
+		// A bullet without any pair can't hit anything, the others are found once per bullet in the sorted pairs.
+		for (uint32_t i = 0; i < m_BulletPairs.size(); ++i) {
+			const BroadphasePair& pair = m_BulletPairs[i];
+			if ((i > 0 && m_BulletPairs[i - 1].IdA == pair.IdA) || pair.BodyA->m_SolverBody == NoSolverBody) continue;
+			SolverBody& body = m_SolverBodies[pair.BodyA->m_SolverBody];
+			if (body.InverseMass <= 0) continue;
+			const SweptMotion motion{body.PreviousPosition - pair.BodyA->GetPosition(), body.Position - body.PreviousPosition};
+			body.Position = body.PreviousPosition + SweepBullet(pair.IdA, *pair.BodyA, motion, getObstacleMotion);
+		}
+
+		// Normal velocity before the substep, the restitution is computed from it.
+		for (SolverContact& contact : m_SolverContacts) {
+			const SolverBody& bodyA = m_SolverBodies[contact.BodyA];
+			const SolverBody& bodyB = m_SolverBodies[contact.BodyB];
+			contact.TargetVelocity = Math::Dot(contact.Contact.CollisionNormal, bodyA.Velocity - bodyB.Velocity);
+			contact.IsTouching = false;
+		}
+	}
+
+	void World::ProjectPositionConstraints(const Real substepTime) {
+		const Real compliance = Solver.Compliance / (substepTime * substepTime);
+		for (SolverContact& contact : m_SolverContacts) {
+			SolverBody& bodyA = m_SolverBodies[contact.BodyA];
+			SolverBody& bodyB = m_SolverBodies[contact.BodyB];
+
+			// Shapes don't rotate: the penetration only changes with the relative movement along the normal.
+			const Vec2 relativeMovement = (bodyA.Position - bodyA.Body->GetPosition()) - (bodyB.Position - bodyB.Body->GetPosition());
+			const Real penetration = contact.Contact.Interpenetration - Math::Dot(contact.Contact.CollisionNormal, relativeMovement);
+			if (penetration <= 0) continue;
+
+			// One projection per substep, so the XPBD multiplier always starts from zero.
+			const Real correction = penetration / (1_r / contact.NormalMass + compliance);
+			contact.Impulse += correction;
+			contact.IsTouching = true;
+
+			const Vec2 directedCorrection = contact.Contact.CollisionNormal * correction;
+			if (bodyA.InverseMass > 0) bodyA.Position += directedCorrection * bodyA.InverseMass;
+			if (bodyB.InverseMass > 0) bodyB.Position -= directedCorrection * bodyB.InverseMass;
+		}
+	}
+
+	void World::UpdateSubstepVelocities(const Real substepTime) {
+		for (SolverBody& body : m_SolverBodies) {
+			if (body.InverseMass > 0) body.Velocity = (body.Position - body.PreviousPosition) / substepTime;
+		}
+
+		// The projection removed the approaching velocity, give back the bounce. Below the velocity the accelerations build
+		// in two substeps the contact is resting and must not bounce at all.
+		for (const SolverContact& contact : m_SolverContacts) {
+			if (!contact.IsTouching) continue;
+			SolverBody& bodyA = m_SolverBodies[contact.BodyA];
+			SolverBody& bodyB = m_SolverBodies[contact.BodyB];
+			const Vec2& normal = contact.Contact.CollisionNormal;
+
+			const Real approachVelocity = -contact.TargetVelocity;
+			const Real restingVelocity = 2_r * Math::Abs(Math::Dot(normal, bodyA.Acceleration - bodyB.Acceleration)) * substepTime;
+			Real rebound = 0;
+			if (approachVelocity > restingVelocity) {
+				rebound = (bodyA.Body->GetRebound() * bodyA.InverseMass + bodyB.Body->GetRebound() * bodyB.InverseMass) * contact.NormalMass;
+			}
+
+			const Real normalVelocity = Math::Dot(normal, bodyA.Velocity - bodyB.Velocity);
+			const Real velocityChange = (std::max(0_r, approachVelocity * rebound) - normalVelocity) * contact.NormalMass;
+			if (bodyA.InverseMass > 0) bodyA.Velocity += normal * (velocityChange * bodyA.InverseMass);
+			if (bodyB.InverseMass > 0) bodyB.Velocity -= normal * (velocityChange * bodyB.InverseMass);
 		}
 	}
 
@@ -283,10 +1072,9 @@ namespace FYC {
 
 		if (const AABB* boundsAABB = std::get_if<AABB>(&Bounds))
 		{
-			// for (auto& particle : *this)
-			for (auto it = begin(); it != end(); ++it)
+			for (const auto& [id, particlePtr] : m_StepParticles)
 			{
-				auto& particle = *it;
+				Particle& particle = *particlePtr;
 				if (!particle.IsKinematic() || !particle.IsAwake()) continue;
 
 				bool changed = false;
@@ -337,7 +1125,7 @@ namespace FYC {
 				if (changed) {
 					Math::NormalizeInPlace(contactNormal);
 					Real inter = Math::Magnitude(position - initialPosition);
-					m_TotalFrameCollisions[it.GetID()][NULL_ID] = {initialPosition + contactNormal * (inter * 0.5), contactNormal, inter, true};
+					AddFrameCollision(id, NULL_ID, {initialPosition + contactNormal * (inter * 0.5), contactNormal, inter, true});
 					particle.SetPosition(position);
 
 					if (impulse.x != 0 || impulse.y != 0)
@@ -356,69 +1144,565 @@ namespace FYC {
 		}
 	}
 
-	void World::Integrate(Real stepTime) {
-		for (auto& particle : *this)
-		{
-			if (!particle.IsKinematic() || !particle.IsAwake()) continue;
-			particle.SetPosition(particle.GetPosition() + particle.m_Velocity * stepTime);
-			particle.SetVelocity(particle.GetVelocity() + particle.m_ConstantAccelerations * stepTime + particle.m_SummedAccelerations * stepTime);
-			particle.m_SummedAccelerations = Vec2{};
-		}
-	}
-
-	void World::PutParticlesToSleep(const Real stepTime) {
-		for (auto& particle : *this) {
-			if (!particle.IsKinematic() || !particle.IsAwake()) continue;
-			const Vec2 pos = particle.GetPosition();
-			const Vec2 prevPos = particle.m_PreviousPosition;
-			const Real distPrev = Math::Magnitude(prevPos - pos);
-			if (distPrev < EpsilonToBeStill) {
-				if (particle.m_AsleepDuration > TimeStill)
-					particle.Sleep();
-				else
-					particle.m_AsleepDuration += stepTime;
-			} else {
-				particle.m_AsleepDuration = 0;
-				particle.m_PreviousPosition = pos;
+	void World::AddFrameCollision(const ID id, const ID otherId, const Collision& collision) {
+		// Stored both ways so the contacts of a particle are found together, the bounds only on the particle side.
+		const auto order = static_cast<uint32_t>(m_TotalFrameCollisions.size());
+		m_TotalFrameCollisions.push_back({id, otherId, order, collision});
+		if (otherId != NULL_ID) m_TotalFrameCollisions.push_back({otherId, id, order, collision});
+	}
+
+	void World::SortFrameCollisions() {
+		// A pair met by several passes keeps the contact of the last one: the latest record of a pair is sorted first and kept.
+		std::sort(m_TotalFrameCollisions.begin(), m_TotalFrameCollisions.end(), [](const FrameCollision& a, const FrameCollision& b) {
+			return std::tie(a.Id, a.OtherId, b.Order) < std::tie(b.Id, b.OtherId, a.Order);
+		});
+		const auto last = std::unique(m_TotalFrameCollisions.begin(), m_TotalFrameCollisions.end(), [](const FrameCollision& a, const FrameCollision& b) {
+			return a.Id == b.Id && a.OtherId == b.OtherId;
+		});
+		m_TotalFrameCollisions.erase(last, m_TotalFrameCollisions.end());
+	}
+
+	void World::GatherBulletPairs() {
+		m_BulletPairs.clear();
+		const auto isBullet = [](const Particle& particle) { return particle.IsBullet() && particle.IsKinematic(); };
+		for (const BroadphasePair& pair : m_BroadphasePairs) {
+			if (isBullet(*pair.BodyA)) m_BulletPairs.push_back(pair);
+			if (isBullet(*pair.BodyB)) m_BulletPairs.push_back({pair.IdB, pair.BodyB, pair.IdA, pair.BodyA});
+		}
+		std::sort(m_BulletPairs.begin(), m_BulletPairs.end(), [](const BroadphasePair& a, const BroadphasePair& b) {
+			return std::tie(a.IdA, a.IdB) < std::tie(b.IdA, b.IdB);
+		});
+	}
+
+	Vec2 World::SweepBullet(const ID id, const Particle& bullet, const SweptMotion& motion, const FunctionRef<SweptMotion(const Particle& obstacle)> getObstacleMotion) const {
+		const auto firstPair = std::lower_bound(m_BulletPairs.cbegin(), m_BulletPairs.cend(), id, [](const BroadphasePair& pair, const ID key) { return pair.IdA < key; });
+		Particle::Shape shape = Translate(bullet.m_Shape, motion.Offset);
+		Vec2 travelled{};
+		Vec2 remaining = motion.Movement;
+		// Part of the movement already done, the obstacles are moved as far along theirs.
+		Real elapsed = 0;
+		for (uint32_t sweep = 0; sweep < MaxBulletSweeps; ++sweep) {
+			if (Math::MagnitudeSqr(remaining) <= 0) return travelled;
+
+			TimeOfImpact firstImpact{{0,0}, 1, false};
+			for (auto pair = firstPair; pair != m_BulletPairs.cend() && pair->IdA == id; ++pair) {
+				const Particle& other = *pair->BodyB;
+				const SweptMotion otherMotion = getObstacleMotion(other);
+				const Particle::Shape otherShape = Translate(other.m_Shape, otherMotion.Offset + otherMotion.Movement * elapsed);
+				const Vec2 relativeMovement = remaining - otherMotion.Movement * (1_r - elapsed);
+				const TimeOfImpact impact = std::visit([&relativeMovement](const auto& a, const auto& b) {
+					return CollisionDetector::Sweep(a, relativeMovement, b);
+				}, shape, otherShape);
+				if (impact && (!firstImpact || impact.Time < firstImpact.Time)) firstImpact = impact;
 			}
+
+			if (!firstImpact) return travelled + remaining;
+
+			// Stop slightly inside the first particle hit so the collision is resolved during this step,
+			// and slide along the contact for the rest of the movement, swept again.
+			const Real time = std::min(1_r, firstImpact.Time + ContinuousCollisionSkin / Math::Magnitude(remaining));
+			const Vec2 rest = remaining * (1_r - time);
+			const Real restAlongNormal = Math::Dot(rest, firstImpact.CollisionNormal);
+			if (restAlongNormal >= 0) return travelled + remaining;
+
+			travelled += remaining * time;
+			shape = Translate(shape, remaining * time);
+			elapsed += (1_r - elapsed) * time;
+			remaining = rest - firstImpact.CollisionNormal * restAlongNormal;
 		}
+
+		// Still blocked after the last sweep: stop at the last contact rather than slide where nothing was checked.
+		return travelled;
 	}
 
-	void World::DragParticles() {
-		for (auto& particle : *this) {
-			if (!particle.IsKinematic() || !particle.IsAwake()) continue;
-			particle.SetVelocity(particle.GetVelocity() * particle.GetDrag());
+	void World::Integrate(const Real stepTime) {
+		IntegratePositions(stepTime);
+		IntegrateVelocities(stepTime);
+	}
+
+	void World::IntegratePositions(const Real stepTime) {
+		// Bullets are swept against the positions at the start of the step, before anything moved,
+		// the other particles moving as they are integrated below: the static and sleeping ones hold still.
+		m_BulletMovements.clear();
+		const auto getObstacleMotion = [stepTime](const Particle& obstacle) {
+			return SweptMotion{{}, obstacle.IsKinematic() && obstacle.IsAwake() ? obstacle.m_Velocity * stepTime : Vec2{}};
+		};
+		for (const auto& [id, particle] : m_StepParticles) {
+			if (!particle->IsBullet() || !particle->IsKinematic() || !particle->IsAwake()) continue;
+			m_BulletMovements.emplace_back(particle, SweepBullet(id, *particle, {{}, particle->m_Velocity * stepTime}, getObstacleMotion));
+		}
+
+		ParallelFor(static_cast<uint32_t>(m_StepParticles.size()), ParticleGrainSize, [this, stepTime](const uint32_t begin, const uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				Particle& particle = *m_StepParticles[i].second;
+				if (!particle.IsKinematic() || !particle.IsAwake() || particle.IsBullet()) continue;
+				particle.SetPosition(particle.GetPosition() + particle.m_Velocity * stepTime);
+			}
+		});
+
+		for (const auto& [particle, movement] : m_BulletMovements) {
+			particle->SetPosition(particle->GetPosition() + movement);
 		}
 	}
 
+	void World::IntegrateVelocities(const Real stepTime) {
+		ParallelFor(static_cast<uint32_t>(m_StepParticles.size()), ParticleGrainSize, [this, stepTime](const uint32_t begin, const uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				Particle& particle = *m_StepParticles[i].second;
+				if (!particle.IsKinematic() || !particle.IsAwake()) continue;
+				particle.SetVelocity(particle.GetVelocity() + particle.m_ConstantAccelerations * stepTime + particle.m_SummedAccelerations * stepTime);
+			}
+		});
+	}
+
+	void World::ClearAccelerations() {
+		// The accelerations added by the user last for the whole step, every substep included.
+		ParallelFor(static_cast<uint32_t>(m_StepParticles.size()), ParticleGrainSize, [this](const uint32_t begin, const uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				Particle& particle = *m_StepParticles[i].second;
+				if (particle.IsKinematic() && particle.IsAwake()) particle.m_SummedAccelerations = Vec2{};
+			}
+		});
+	}
+
+	void World::EvaluateSleep(const Real stepTime) {
+		m_SleepRequests.assign(m_StepParticles.size(), 0);
+
+		// Putting particles to sleep only saves time on the next steps, it can wait for a step with time left.
+		if (IsOverBudget()) {
+			m_StepStatistics.SleepDeferred = true;
+			return;
+		}
+
+		ParallelFor(static_cast<uint32_t>(m_StepParticles.size()), ParticleGrainSize, [this, stepTime](const uint32_t begin, const uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				Particle& particle = *m_StepParticles[i].second;
+				if (!particle.IsKinematic() || !particle.IsAwake()) continue;
+				const Vec2 pos = particle.GetPosition();
+				const Vec2 prevPos = particle.m_PreviousPosition;
+				const Real distPrev = Math::Magnitude(prevPos - pos);
+				if (distPrev < EpsilonToBeStill) {
+					if (particle.m_AsleepDuration > TimeStill)
+						m_SleepRequests[i] = 1;
+					else
+						particle.m_AsleepDuration += stepTime;
+				} else {
+					particle.m_AsleepDuration = 0;
+					particle.m_PreviousPosition = pos;
+				}
+			}
+		});
+	}
+
+	void World::PutParticlesToSleep() {
+		ParallelFor(static_cast<uint32_t>(m_SleepRequests.size()), ParticleGrainSize, [this](const uint32_t begin, const uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				if (m_SleepRequests[i]) m_StepParticles[i].second->Sleep();
+			}
+		});
+	}
+
+	void World::DragParticles() {
+		ParallelFor(static_cast<uint32_t>(m_StepParticles.size()), ParticleGrainSize, [this](const uint32_t begin, const uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				Particle& particle = *m_StepParticles[i].second;
+				if (!particle.IsKinematic() || !particle.IsAwake()) continue;
+				particle.SetVelocity(particle.GetVelocity() * particle.GetDrag());
+			}
+		});
+	}
+
 	void World::InvokeCollisionsCallbacks() {
-		for (auto&[id, callback] : m_CollisionCallbacks) {
-			if (!m_TotalFrameCollisions.contains(id)) continue;
-			for (auto&[ otherId, collision] : m_TotalFrameCollisions.at(id)) {
-				callback(WorldIterator{this, id}, WorldIterator{this, otherId}, collision);
+		if (m_CollisionListeners.empty()) return;
+		for (CollisionListenerEntry& entry : m_CollisionListeners) entry.Records.clear();
+
+		// Whichever is smaller of the listened particles and the collisions is walked, the other is looked up.
+		if (m_ListenedParticles.size() < m_TotalFrameCollisions.size()) {
+			for (const auto& [id, listener] : m_ListenedParticles) {
+				auto it = std::lower_bound(m_TotalFrameCollisions.cbegin(), m_TotalFrameCollisions.cend(), id, [](const FrameCollision& collision, const ID value) { return collision.Id < value; });
+				if (it == m_TotalFrameCollisions.cend() || it->Id != id) continue;
+				std::pmr::vector<CollisionRecord>& records = m_CollisionListeners[listener].Records;
+				for (; it != m_TotalFrameCollisions.cend() && it->Id == id; ++it) records.push_back({id, it->OtherId, it->Contact});
+			}
+		} else {
+			// The collisions are sorted by particle, the listener is looked up once per particle.
+			std::pmr::vector<CollisionRecord>* records = nullptr;
+			ID currentId = NULL_ID;
+			for (const FrameCollision& collision : m_TotalFrameCollisions) {
+				if (!records || collision.Id != currentId) {
+					currentId = collision.Id;
+					const auto listener = m_ListenedParticles.find(currentId);
+					records = listener == m_ListenedParticles.end() ? nullptr : &m_CollisionListeners[listener->second].Records;
+					if (!records) continue;
+				}
+				records->push_back({collision.Id, collision.OtherId, collision.Contact});
 			}
 		}
+
+		m_InvokingCollisionListeners = true;
+		for (CollisionListenerEntry& entry : m_CollisionListeners) {
+			if (!entry.Records.empty()) entry.Listener->OnCollisions(*this, entry.Records);
+		}
+		m_InvokingCollisionListeners = false;
+		for (auto i = static_cast<uint32_t>(m_CollisionListeners.size()); i-- > 0;) {
+			if (m_CollisionListeners[i].ParticleCount == 0) RemoveCollisionListener(*m_CollisionListeners[i].Listener);
+		}
 	}
 
-	void World::Step(const Real stepTime)
+	void World::DispatchContactEvents() {
+		if (m_ContactListeners.empty()) {
+			m_ActiveContacts.clear();
+			return;
+		}
+
+		const bool hasPersistListener = std::any_of(m_ContactListeners.begin(), m_ContactListeners.end(), [](const auto& entry) { return entry.second.Filter.Persist; });
+
+		// The frame contacts are stored both ways, the bounds (NULL_ID) only on the particle side, which is always the smallest ID.
+		// They are sorted by particle, so the contacts kept are sorted by pair.
+		m_StepContacts.clear();
+		for (const FrameCollision& collision : m_TotalFrameCollisions) {
+			if (collision.Id < collision.OtherId) m_StepContacts.emplace_back(std::pair{collision.Id, collision.OtherId}, collision.Contact);
+		}
+
+		m_ContactEvents.clear();
+		for (const auto& [pair, collision] : m_StepContacts) {
+			const bool isActive = FindPair(m_ActiveContacts, pair) != m_ActiveContacts.cend();
+			if (isActive && !hasPersistListener) continue;
+			m_ContactEvents.push_back({isActive ? ContactEventType::Persist : ContactEventType::Begin, pair.first, pair.second, collision});
+		}
+		for (const auto& [pair, collision] : m_ActiveContacts) {
+			if (FindPair(m_StepContacts, pair) == m_StepContacts.cend()) m_ContactEvents.push_back({ContactEventType::End, pair.first, pair.second, collision});
+		}
+		std::swap(m_ActiveContacts, m_StepContacts);
+		if (m_ContactEvents.empty()) return;
+
+		std::sort(m_ContactEvents.begin(), m_ContactEvents.end(), [](const ContactEvent& a, const ContactEvent& b) {
+			return std::tuple(GetContactEventRank(a.Type), a.IdA, a.IdB) < std::tuple(GetContactEventRank(b.Type), b.IdA, b.IdB);
+		});
+		const auto beginEvents = std::find_if(m_ContactEvents.cbegin(), m_ContactEvents.cend(), [](const ContactEvent& event) { return event.Type != ContactEventType::Persist; });
+		const auto endEvents = std::find_if(beginEvents, m_ContactEvents.cend(), [](const ContactEvent& event) { return event.Type == ContactEventType::End; });
+
+		for (const auto& [handle, entry] : m_ContactListeners) {
+			const ContactEventFilter& filter = entry.Filter;
+			// Every filter but Persist and End together is a contiguous range of the sorted events.
+			std::span<const ContactEvent> events;
+			if (filter.Persist && !filter.Begin && filter.End) {
+				m_FilteredContactEvents.assign(m_ContactEvents.cbegin(), beginEvents);
+				m_FilteredContactEvents.insert(m_FilteredContactEvents.end(), endEvents, m_ContactEvents.cend());
+				events = m_FilteredContactEvents;
+			} else {
+				const auto first = filter.Persist ? m_ContactEvents.cbegin() : filter.Begin ? beginEvents : endEvents;
+				const auto last = filter.End ? m_ContactEvents.cend() : filter.Begin ? endEvents : beginEvents;
+				if (first < last) events = {first, last};
+			}
+			if (!events.empty()) entry.Listener(events);
+		}
+	}
+
+	void World::FindSensorOverlaps() {
+		if (m_SensorListeners.empty()) return;
+
+		// Every sensor keeps its own overlaps sorted by particle, the sensors are sorted by ID so the merged list is sorted.
+		m_SensorChunkOverlaps.resize(m_StepSensors.size());
+		ParallelFor(static_cast<uint32_t>(m_StepSensors.size()), SensorGrainSize, [this](const uint32_t begin, const uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				const Particle& sensor = *m_StepSensors[i].second;
+				std::pmr::vector<ID>& overlaps = m_SensorChunkOverlaps[i];
+				overlaps.clear();
+				for (const auto& [id, particle] : m_StepParticles) {
+					if (particle->IsKinematic() && OverlapParticles(sensor, *particle)) overlaps.push_back(id);
+				}
+				std::sort(overlaps.begin(), overlaps.end());
+			}
+		});
+
+		m_StepSensorOverlaps.clear();
+		for (uint32_t i = 0; i < m_StepSensors.size(); ++i) {
+			for (const ID id : m_SensorChunkOverlaps[i]) m_StepSensorOverlaps.emplace_back(m_StepSensors[i].first, id);
+		}
+	}
+
+	void World::DispatchSensorEvents() {
+		if (m_SensorListeners.empty()) {
+			m_ActiveSensorOverlaps.clear();
+			return;
+		}
+
+		// Both lists are sorted: the overlaps only in the new one began, the ones only in the old one ended.
+		m_SensorEvents.clear();
+		const auto addEvents = [this](const ContactEventType type, const std::pmr::vector<std::pair<ID, ID>>& overlaps, const std::pmr::vector<std::pair<ID, ID>>& others) {
+			for (const auto& overlap : overlaps) {
+				if (!std::binary_search(others.cbegin(), others.cend(), overlap)) m_SensorEvents.push_back({type, overlap.first, overlap.second});
+			}
+		};
+		addEvents(ContactEventType::Begin, m_StepSensorOverlaps, m_ActiveSensorOverlaps);
+		addEvents(ContactEventType::End, m_ActiveSensorOverlaps, m_StepSensorOverlaps);
+		std::swap(m_ActiveSensorOverlaps, m_StepSensorOverlaps);
+		m_StepSensorOverlaps.clear();
+		if (m_SensorEvents.empty()) return;
+
+		for (const auto& [handle, listener] : m_SensorListeners) listener(m_SensorEvents);
+	}
+
+	void World::StepIterative(const Real stepTime)
 	{
 		// Integration
 		Integrate(stepTime);
 
 		// Collision Detection
-		m_TotalFrameCollisions.clear();
+		m_IterativeCollisions.clear();
 		FindParticlesCollisions();
-		for (int iterations = 0; iterations < 10; ++iterations)
+		for (uint32_t iterations = 0; iterations < Solver.Iterations; ++iterations)
 		{
+			if (iterations > 0 && IsOverBudget()) {
+				m_StepStatistics.SolverIterationsCut = true;
+				break;
+			}
+			++m_StepStatistics.SolverIterations;
+			m_StepStatistics.ContactCount += m_Collisions.size();
 			ResolveParticleCollisions(stepTime);
 			FindAndResolveBoundsCollisions(stepTime);
 			FindParticlesCollisions();
 			if (m_Collisions.size() == 0) break;
 		}
+		for (const auto& [pair, collision] : m_IterativeCollisions) AddFrameCollision(pair.first, pair.second, collision);
+	}
+
+	void World::StepSpeculative(const Real stepTime)
+	{
+		// The velocities are integrated first so the contacts are solved against the velocities that will move the particles.
+		IntegrateVelocities(stepTime);
+
+		FindParticlesCollisions(stepTime);
+		SolveVelocityConstraints(stepTime);
+
+		IntegratePositions(stepTime);
+		FindAndResolveBoundsCollisions(stepTime);
+	}
+
+	void World::StepSubstepped(const Real stepTime)
+	{
+		const uint32_t substeps = std::max(1u, Solver.Substeps);
+		const Real substepTime = stepTime / static_cast<Real>(substeps);
+
+		// The contacts the particles may reach during the whole step are gathered once, the substeps only move them.
+		FindParticlesCollisions(stepTime);
+		BuildVelocityConstraints(stepTime, true);
+
+		for (uint32_t substep = 0; substep < substeps; ++substep) {
+			Real currentSubstepTime = substepTime;
+			if (substep > 0 && substep + 1 < substeps && IsOverBudget()) {
+				// Out of time: cover the rest of the step at once, less accurate but the particles still reach the end of the step.
+				m_StepStatistics.SubstepsMerged = true;
+				currentSubstepTime = substepTime * static_cast<Real>(substeps - substep);
+				substep = substeps - 1;
+			}
+			++m_StepStatistics.SolverIterations;
+			IntegrateSubstep(currentSubstepTime);
+			ProjectPositionConstraints(currentSubstepTime);
+			UpdateSubstepVelocities(currentSubstepTime);
+		}
+
+		for (const SolverBody& body : m_SolverBodies) {
+			if (body.InverseMass <= 0) continue;
+			body.Body->SetPosition(body.Position);
+			body.Body->SetVelocity(body.Velocity);
+		}
+		StoreSolverContacts(false);
+
+		FindAndResolveBoundsCollisions(stepTime);
+	}
+
+	bool World::IsOverBudget() const
+	{
+		return m_StepDeadline != Clock::time_point::max() && Clock::now() >= m_StepDeadline;
+	}
+
+	void World::StepSolver(const Real stepTime)
+	{
+		switch (Solver.Type) {
+			case SolverType::Iterative:
+				StepIterative(stepTime);
+				break;
+			case SolverType::Speculative:
+			case SolverType::SequentialImpulse:
+				StepSpeculative(stepTime);
+				break;
+			case SolverType::Substepping:
+				StepSubstepped(stepTime);
+				break;
+		}
+	}
+
+	void World::PrepareParallelStep()
+	{
+		if (Solver.ThreadCount > 1) {
+			if (!m_JobSystem || m_JobSystem->GetThreadCount() != Solver.ThreadCount) m_JobSystem = std::make_shared<JobSystem>(Solver.ThreadCount);
+		} else {
+			m_JobSystem.reset();
+		}
+
+		// The particles can't be added or removed until the callbacks, the step works on an indexable list of them.
+		m_StepParticles.clear();
+		m_StepParticles.reserve(m_Particles.size());
+		m_StepSensors.clear();
+		for (auto& [id, particle] : m_Particles) {
+			if (particle.IsSensor()) m_StepSensors.emplace_back(id, &particle);
+			else m_StepParticles.emplace_back(id, &particle);
+		}
+		std::sort(m_StepSensors.begin(), m_StepSensors.end());
+	}
 
-		PutParticlesToSleep(stepTime);
-		DragParticles();
+	void World::ParallelFor(const uint32_t count, const uint32_t grainSize, const JobSystem::RangeJob job)
+	{
+		if (m_JobSystem) {
+			m_JobSystem->ParallelFor(count, grainSize, job);
+			return;
+		}
+		// Same chunks as the job system, the per chunk results are the same without it.
+		for (uint32_t begin = 0; begin < count; begin += grainSize) job(begin, std::min(count, begin + grainSize));
+	}
+
+	void World::Step(const Real stepTime)
+	{
+		Step(stepTime, 1, Clock::duration::max());
+	}
+
+	void World::Step(const Real stepTime, const Clock::duration budget)
+	{
+		Step(stepTime, 1, budget);
+	}
+
+	void World::Step(const Real stepTime, uint32_t substeps, const Clock::duration budget)
+	{
+		const Clock::time_point start = Clock::now();
+		const uint64_t startAllocations = GetAllocationCount();
+		m_StepDeadline = budget == Clock::duration::max() ? Clock::time_point::max() : start + budget;
+		m_StepStatistics = {};
+		m_TotalFrameCollisions.clear();
+		if (!m_CommandBuffer.IsEmpty()) ApplyCommands(m_CommandBuffer);
+		PrepareParallelStep();
+
+		m_StepSubsteps = std::max(1u, substeps);
+		m_StepGraph.Run(*this, stepTime, m_JobSystem.get());
+
+		// The sync point of the step: what the callbacks and the stages recorded is applied once they are all done.
+		if (!m_CommandBuffer.IsEmpty()) ApplyCommands(m_CommandBuffer);
+
+		m_StepStatistics.Duration = Clock::now() - start;
+		m_StepStatistics.HeapAllocations = GetAllocationCount() - startAllocations;
+		UpdatePeakMemoryStats();
+		m_StepDeadline = Clock::time_point::max();
+	}
+
+	void World::StepSubsteps(const Real stepTime)
+	{
+		const Real substepTime = stepTime / static_cast<Real>(m_StepSubsteps);
+		m_UseBroadphasePairs = m_StepSubsteps > 1;
+		// The bullets are only swept against the particles their frame bounds reach.
+		const bool hasBullets = std::any_of(m_StepParticles.begin(), m_StepParticles.end(), [](const auto& entry) {
+			return entry.second->IsBullet() && entry.second->IsKinematic();
+		});
+		if (m_UseBroadphasePairs || hasBullets) BuildBroadphasePairs(stepTime);
+		if (hasBullets) GatherBulletPairs();
+		else m_BulletPairs.clear();
+
+		for (uint32_t substep = 0; substep < m_StepSubsteps; ++substep) {
+			Real currentSubstepTime = substepTime;
+			if (substep > 0 && substep + 1 < m_StepSubsteps && IsOverBudget()) {
+				m_StepStatistics.SubstepsMerged = true;
+				currentSubstepTime = substepTime * static_cast<Real>(m_StepSubsteps - substep);
+				substep = m_StepSubsteps - 1;
+			}
+			StepSolver(currentSubstepTime);
+		}
+		m_UseBroadphasePairs = false;
+		SortFrameCollisions();
+	}
+
+	StepGraph World::CreateStepGraph()
+	{
+		using Resource = StepResource;
+		StepGraph graph;
+		graph.AddStage({"Solve",
+			Resource::Positions | Resource::Velocities | Resource::Accelerations | Resource::Awake | Resource::Contacts | Resource::Statistics,
+			Resource::Positions | Resource::Velocities | Resource::Awake | Resource::Contacts | Resource::Statistics,
+			[](World& world, const Real stepTime) { world.StepSubsteps(stepTime); }});
+		graph.AddStage({"ClearAccelerations", Resource::Awake, Resource::Accelerations,
+			[](World& world, Real) { world.ClearAccelerations(); }});
+		graph.AddStage({"EvaluateSleep", Resource::Positions | Resource::Awake | Resource::SleepTimers | Resource::Statistics, Resource::SleepTimers | Resource::Statistics,
+			[](World& world, const Real stepTime) { world.EvaluateSleep(stepTime); }});
+		graph.AddStage({"Sleep", Resource::SleepTimers, Resource::Awake,
+			[](World& world, Real) { world.PutParticlesToSleep(); }});
+		// The drag reads the awake state the sleep leaves, the particles falling asleep keep their velocity.
+		graph.AddStage({"Drag", Resource::Awake | Resource::Velocities, Resource::Awake | Resource::Velocities,
+			[](World& world, Real) { world.DragParticles(); }});
+		// The overlaps are found before the callbacks may remove particles, and reported once the contacts are.
+		graph.AddStage({"Sensors", Resource::Positions, Resource::Contacts,
+			[](World& world, Real) { world.FindSensorOverlaps(); }});
+		// The callbacks and the listeners may do anything to the world.
+		graph.AddStage({"Callbacks", Resource::All, Resource::All,
+			[](World& world, Real) { world.InvokeCollisionsCallbacks(); }});
+		graph.AddStage({"ContactEvents", Resource::All, Resource::All,
+			[](World& world, Real) { world.DispatchContactEvents(); }});
+		graph.AddStage({"SensorEvents", Resource::All, Resource::All,
+			[](World& world, Real) { world.DispatchSensorEvents(); }});
+		return graph;
+	}
+
+	const StepStatistics& World::GetStepStatistics() const {
+		return m_StepStatistics;
+	}
+
+	MemoryStats World::GetMemoryStats() const {
+		MemoryStats stats;
+		stats.Particles = HashMapBytes(m_Particles) + VectorBytes(m_StepParticles) + VectorBytes(m_StepSensors) + VectorBytes(m_SleepRequests) + VectorBytes(m_BulletMovements) + VectorBytes(m_RemovedParticles);
+		stats.Contacts = VectorBytes(m_Collisions) + NestedVectorBytes(m_ChunkCollisions) + VectorBytes(m_ActiveContacts) + VectorBytes(m_StepContacts)
+			+ VectorBytes(m_TotalFrameCollisions) + VectorBytes(m_ContactImpulses) + VectorBytes(m_ResolvedCollisions) + VectorBytes(m_IterativeCollisions)
+			+ VectorBytes(m_IterativeCollisionsScratch) + VectorBytes(m_SolverBodies) + VectorBytes(m_SolverContacts) + VectorBytes(m_SolverContactsScratch)
+			+ VectorBytes(m_SolverBatchOffsets) + VectorBytes(m_SolverChunkResiduals);
+		stats.Events = VectorBytes(m_ContactEvents) + VectorBytes(m_FilteredContactEvents) + VectorBytes(m_SensorEvents) + VectorBytes(m_ActiveSensorOverlaps)
+			+ VectorBytes(m_StepSensorOverlaps) + NestedVectorBytes(m_SensorChunkOverlaps);
+		for (const CollisionListenerEntry& entry : m_CollisionListeners) stats.Events += VectorBytes(entry.Records);
+		stats.Callbacks = VectorBytes(m_CollisionListeners) + HashMapBytes(m_ListenedParticles) + TreeMapBytes(m_ContactListeners) + TreeMapBytes(m_SensorListeners)
+			+ VectorBytes(m_StepGraph.GetStages());
+		stats.Broadphase = VectorBytes(m_BroadphaseBoxes) + VectorBytes(m_BroadphasePairs) + VectorBytes(m_BulletPairs) + NestedVectorBytes(m_ChunkBroadphasePairs);
+		stats.Commands = VectorBytes(m_CommandBuffer.m_Commands) + VectorBytes(m_CommandBuffer.m_Particles) + VectorBytes(m_PendingCommands);
+		return stats;
+	}
+
+	MemoryStats World::GetMemoryStats(const FunctionRef<uint64_t(const std::any& data)> userDataSize) const {
+		MemoryStats stats = GetMemoryStats();
+		for (const auto& [id, particle] : m_Particles) {
+			if (particle.Data.has_value()) stats.UserData += userDataSize(particle.Data);
+		}
+		return stats;
+	}
+
+	const MemoryStats& World::GetPeakMemoryStats() const {
+		return m_PeakMemoryStats;
+	}
+
+	uint64_t World::GetPeakTotalMemory() const {
+		return m_PeakTotalMemory;
+	}
+
+	void World::UpdatePeakMemoryStats() {
+		const MemoryStats stats = GetMemoryStats();
+		m_PeakMemoryStats.Particles = std::max(m_PeakMemoryStats.Particles, stats.Particles);
+		m_PeakMemoryStats.Contacts = std::max(m_PeakMemoryStats.Contacts, stats.Contacts);
+		m_PeakMemoryStats.Events = std::max(m_PeakMemoryStats.Events, stats.Events);
+		m_PeakMemoryStats.Callbacks = std::max(m_PeakMemoryStats.Callbacks, stats.Callbacks);
+		m_PeakMemoryStats.Broadphase = std::max(m_PeakMemoryStats.Broadphase, stats.Broadphase);
+		m_PeakMemoryStats.Commands = std::max(m_PeakMemoryStats.Commands, stats.Commands);
+		m_PeakTotalMemory = std::max(m_PeakTotalMemory, stats.GetTotal());
+	}
+
+	StepGraph& World::GetStepGraph() {
+		return m_StepGraph;
+	}
 
-		InvokeCollisionsCallbacks();
+	const StepGraph& World::GetStepGraph() const {
+		return m_StepGraph;
 	}
 } // FYC
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "Physics/WorldScheduler.hpp"
+
+namespace FYC {
+
+	WorldScheduler::WorldScheduler(const uint32_t threadCount)
+	{
+		const uint32_t workerCount = std::max(1u, threadCount);
+		m_Assignments.resize(workerCount);
+		m_Workers.reserve(workerCount);
+		for (uint32_t i = 0; i < workerCount; ++i) {
+			m_Workers.emplace_back(&WorldScheduler::WorkerLoop, this, i);
+		}
+	}
+
+	WorldScheduler::~WorldScheduler()
+	{
+		Wait();
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Stopping = true;
+		}
+		m_WorkAvailable.notify_all();
+		for (std::thread& worker : m_Workers) worker.join();
+	}
+
+	WorldScheduler::WorldHandle WorldScheduler::AddWorld(World& world, const uint32_t affinity)
+	{
+		Wait();
+		const WorldHandle handle = m_HandleGenerator++;
+		m_Worlds[handle] = {&world, affinity};
+		return handle;
+	}
+
+	void WorldScheduler::RemoveWorld(const WorldHandle handle)
+	{
+		Wait();
+		m_Worlds.erase(handle);
+	}
+
+	void WorldScheduler::SetAffinity(const WorldHandle handle, const uint32_t affinity)
+	{
+		Wait();
+		const auto it = m_Worlds.find(handle);
+		if (it != m_Worlds.end()) it->second.Affinity = affinity;
+	}
+
+	uint32_t WorldScheduler::GetThreadCount() const
+	{
+		return static_cast<uint32_t>(m_Workers.size());
+	}
+
+	uint64_t WorldScheduler::GetWorldCount() const
+	{
+		return m_Worlds.size();
+	}
+
+	std::shared_future<void> WorldScheduler::StepAsync(const Real stepTime, const uint32_t substeps)
+	{
+		Wait();
+		AssignWorlds();
+
+		// The last worker may still be inside set_value once the future is ready, it holds the mutex until it returns.
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Promise = {};
+			m_Future = m_Promise.get_future().share();
+			m_Exception = nullptr;
+			if (m_Worlds.empty()) {
+				m_Promise.set_value();
+				return m_Future;
+			}
+
+			m_StepTime = stepTime;
+			m_Substeps = substeps;
+			m_PendingThreads = GetThreadCount();
+			++m_Generation;
+		}
+		m_WorkAvailable.notify_all();
+		return m_Future;
+	}
+
+	void WorldScheduler::Wait()
+	{
+		if (m_Future.valid()) m_Future.wait();
+	}
+
+	void WorldScheduler::Step(const Real stepTime, const uint32_t substeps)
+	{
+		StepAsync(stepTime, substeps).get();
+	}
+
+	void WorldScheduler::AssignWorlds()
+	{
+		for (std::vector<World*>& assignment : m_Assignments) assignment.clear();
+		std::vector<uint64_t> loads(m_Assignments.size(), 0);
+
+		// Pinned worlds first, then the heaviest worlds go to the least loaded thread (longest processing time first).
+		// Every world costs at least one, a world that is asleep still has to be stepped.
+		std::vector<std::pair<uint64_t, World*>> balancedWorlds;
+		for (const auto& [handle, world] : m_Worlds) {
+			const uint64_t load = world.Target->CountActiveParticles() + 1;
+			if (world.Affinity != NoAffinity) {
+				const uint32_t thread = world.Affinity % GetThreadCount();
+				m_Assignments[thread].push_back(world.Target);
+				loads[thread] += load;
+			} else {
+				balancedWorlds.emplace_back(load, world.Target);
+			}
+		}
+
+		std::stable_sort(balancedWorlds.begin(), balancedWorlds.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+		for (const auto& [load, world] : balancedWorlds) {
+			const auto thread = static_cast<uint32_t>(std::min_element(loads.begin(), loads.end()) - loads.begin());
+			m_Assignments[thread].push_back(world);
+			loads[thread] += load;
+		}
+	}
+
+	void WorldScheduler::WorkerLoop(const uint32_t thread)
+	{
+		uint64_t generation = 0;
+		while (true) {
+			Real stepTime;
+			uint32_t substeps;
+			{
+				std::unique_lock lock(m_Mutex);
+				m_WorkAvailable.wait(lock, [this, generation]() { return m_Stopping || m_Generation != generation; });
+				if (m_Stopping) return;
+				generation = m_Generation;
+				stepTime = m_StepTime;
+				substeps = m_Substeps;
+			}
+
+			for (World* world : m_Assignments[thread]) {
+				try {
+					world->Step(stepTime, substeps);
+				} catch (...) {
+					std::lock_guard lock(m_Mutex);
+					if (!m_Exception) m_Exception = std::current_exception();
+				}
+			}
+
+			if (m_PendingThreads.fetch_sub(1) == 1) {
+				std::lock_guard lock(m_Mutex);
+				if (m_Exception) m_Promise.set_exception(m_Exception);
+				else m_Promise.set_value();
+			}
+		}
+	}
+
+} // FYC
@@ -0,0 +1,64 @@
+#include "Physics/World.hpp"
+#include "Check.hpp"
+
+using namespace FYC;
+
+namespace {
+
+	void AddBox(World& world, const Vec2& position, const Vec2& size)
+	{
+		Particle box;
+		box.SetRectangleSize(size);
+		box.SetPosition(position);
+		box.SetKinematic(false);
+		world.AddParticle(std::move(box));
+	}
+
+}
+
+// A bullet hitting the floor slides along it into a wall, in a single step: the slide is swept too.
+int main()
+{
+	for (const SolverType type : {SolverType::Iterative, SolverType::Speculative, SolverType::SequentialImpulse, SolverType::Substepping}) {
+		World world;
+		world.Solver.Type = type;
+		AddBox(world, {0, Real{-0.5}}, {100, 1});
+		AddBox(world, {Real{15.5}, 5}, {1, 10});
+		// Far from the bullet, they don't make any pair.
+		for (int32_t i = 0; i < 100; ++i) AddBox(world, {static_cast<Real>(i * 10), 1000}, {1, 1});
+
+		Particle bullet;
+		bullet.SetCircleRadius(Real{0.5});
+		bullet.SetPosition({0, 1});
+		bullet.SetKinematic(true);
+		bullet.SetBullet(true);
+		bullet.SetVelocity({1200, -60});
+		const World::ID bulletId = world.AddParticle(std::move(bullet)).GetID();
+
+		world.Step(Real{1} / 60);
+		const Vec2 position = world.find(bulletId)->GetPosition();
+		FYC_CHECK(position.x < 15);
+		FYC_CHECK(position.y > 0);
+		// Only the floor and the wall are swept against.
+		FYC_CHECK(world.GetStepStatistics().BroadphasePairs == 2);
+	}
+
+	// Pulled from rest, the bullet reaches no contact when the step starts and only the sweep stops it at the wall.
+	for (const SolverType type : {SolverType::Iterative, SolverType::Speculative, SolverType::SequentialImpulse, SolverType::Substepping}) {
+		World world;
+		world.Solver.Type = type;
+		AddBox(world, {Real{5.5}, 0}, {1, 10});
+
+		Particle bullet;
+		bullet.SetCircleRadius(Real{0.5});
+		bullet.SetKinematic(true);
+		bullet.SetBullet(true);
+		bullet.SetConstantAcceleration({60000, 0});
+		const World::ID bulletId = world.AddParticle(std::move(bullet)).GetID();
+
+		for (uint32_t step = 0; step < 2; ++step) world.Step(Real{1} / 60);
+		FYC_CHECK(world.find(bulletId)->GetPosition().x < 5);
+	}
+
+	return Tests::s_Failures;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdio>
+
+namespace FYC::Tests {
+
+	/// Failed checks of the test, its exit code.
+	inline int s_Failures = 0;
+
+} // FYC::Tests
+
+/// Report the condition when it doesn't hold and fail the test, without stopping it.
+#define FYC_CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			++::FYC::Tests::s_Failures; \
+		} \
+	} while (false)
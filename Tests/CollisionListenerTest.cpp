@@ -0,0 +1,102 @@
+#include "Physics/World.hpp"
+#include "Check.hpp"
+
+using namespace FYC;
+
+namespace {
+
+	struct RecordingListener : World::CollisionListener {
+		uint32_t Calls = 0;
+		std::vector<World::CollisionRecord> Records;
+		std::vector<World::ID> ToRemove;
+
+		void OnCollisions(World& world, const std::span<const World::CollisionRecord> records) override
+		{
+			++Calls;
+			Records.assign(records.begin(), records.end());
+			for (const World::ID id : ToRemove) world.RemoveParticle(id);
+			ToRemove.clear();
+		}
+
+		[[nodiscard]] bool HasRecordOf(const World::ID id) const
+		{
+			return std::any_of(Records.begin(), Records.end(), [id](const World::CollisionRecord& record) { return record.Id == id; });
+		}
+	};
+
+	World::ID AddCircle(World& world, const Vec2& position)
+	{
+		Particle circle;
+		circle.SetCircleRadius(1);
+		circle.SetPosition(position);
+		circle.SetKinematic(true);
+		return world.AddParticle(std::move(circle)).GetID();
+	}
+
+	void Reset(RecordingListener& listener)
+	{
+		listener.Calls = 0;
+		listener.Records.clear();
+	}
+
+}
+
+// The contacts of the listened particles are batched in one call per listener and step.
+int main()
+{
+	World world;
+	Particle floor;
+	floor.SetRectangleSize({40, 2});
+	floor.SetPosition({0, -1});
+	floor.SetKinematic(false);
+	world.AddParticle(std::move(floor));
+
+	// Sunk in the floor, they touch it every step.
+	const World::ID a = AddCircle(world, {-10, Real{0.5}});
+	const World::ID b = AddCircle(world, {0, Real{0.5}});
+	const World::ID c = AddCircle(world, {10, Real{0.5}});
+	const World::ID unlistened = AddCircle(world, {15, Real{0.5}});
+
+	RecordingListener first;
+	RecordingListener second;
+	world.Listen(a, first);
+	world.Listen(b, first);
+	world.Listen(c, second);
+
+	world.Step(Real{1} / 60);
+	FYC_CHECK(first.Calls == 1 && second.Calls == 1);
+	FYC_CHECK(first.HasRecordOf(a) && first.HasRecordOf(b) && !first.HasRecordOf(c));
+	FYC_CHECK(second.HasRecordOf(c) && !second.HasRecordOf(a) && !second.HasRecordOf(b));
+	FYC_CHECK(!first.HasRecordOf(unlistened) && !second.HasRecordOf(unlistened));
+
+	// Listening again moves the particle to the other listener.
+	world.Listen(b, second);
+	Reset(first);
+	Reset(second);
+	world.Step(Real{1} / 60);
+	FYC_CHECK(first.HasRecordOf(a) && !first.HasRecordOf(b));
+	FYC_CHECK(second.HasRecordOf(b) && second.HasRecordOf(c));
+
+	// A removed particle isn't listened to anymore, even once its ID is reused.
+	world.RemoveParticle(a);
+	Particle replacement;
+	replacement.SetCircleRadius(1);
+	replacement.SetPosition({-10, Real{0.5}});
+	replacement.SetKinematic(true);
+	world.SetParticle(replacement, a);
+	Reset(first);
+	world.Step(Real{1} / 60);
+	FYC_CHECK(first.Calls == 0);
+
+	// A listener removing its last particle from its callback is dropped once every listener was called.
+	second.ToRemove = {b, c};
+	Reset(second);
+	world.Step(Real{1} / 60);
+	FYC_CHECK(second.Calls == 1);
+	world.SetParticle(replacement, c);
+	Reset(second);
+	world.Step(Real{1} / 60);
+	FYC_CHECK(second.Calls == 0);
+
+	return Tests::s_Failures;
+}
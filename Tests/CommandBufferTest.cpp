@@ -0,0 +1,49 @@
+#include "Physics/World.hpp"
+#include "Check.hpp"
+
+using namespace FYC;
+
+int main()
+{
+	// A buffered Set raises the ID generator like SetParticle, a later AddParticle doesn't take its ID.
+	{
+		World world;
+		const World::ID first = world.AddParticle(Particle::CreateCircle({0, 0}, 1)).GetID();
+		World::CommandBuffer buffer;
+		buffer.SetParticle(Particle::CreateCircle({5, 0}, 1), first + 1);
+		world.ApplyCommands(buffer);
+		FYC_CHECK(world.count() == 2);
+
+		const World::ID added = world.AddParticle(Particle::CreateCircle({10, 0}, 1)).GetID();
+		FYC_CHECK(added != first && added != first + 1);
+		FYC_CHECK(world.count() == 3);
+	}
+
+	// In a single batch, the Adds don't take the ID of a Set queued after them.
+	{
+		World world;
+		World::CommandBuffer buffers[2];
+		buffers[0].AddParticle(Particle::CreateCircle({0, 0}, 1));
+		buffers[0].AddParticle(Particle::CreateCircle({2, 0}, 1));
+		buffers[1].SetParticle(Particle::CreateCircle({4, 0}, 1), 0);
+		buffers[1].SetParticle(Particle::CreateCircle({6, 0}, 1), 1);
+		world.ApplyCommands(buffers);
+		FYC_CHECK(world.count() == 4);
+		FYC_CHECK(world.find(0) != world.end() && world.find(0)->GetPosition().x == 4);
+		FYC_CHECK(world.find(1) != world.end() && world.find(1)->GetPosition().x == 6);
+	}
+
+	// Only the last command of a particle counts, and a removed particle is gone.
+	{
+		World world;
+		const World::ID id = world.AddParticle(Particle::CreateCircle({0, 0}, 1)).GetID();
+		World::CommandBuffer buffer;
+		buffer.SetParticle(Particle::CreateCircle({3, 0}, 1), id);
+		buffer.RemoveParticle(id);
+		world.ApplyCommands(buffer);
+		FYC_CHECK(world.count() == 0);
+		FYC_CHECK(buffer.IsEmpty());
+	}
+
+	return Tests::s_Failures;
+}
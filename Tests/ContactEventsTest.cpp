@@ -0,0 +1,81 @@
+#include "Physics/World.hpp"
+#include "Check.hpp"
+
+using namespace FYC;
+
+namespace {
+
+	struct ExpectedEvent {
+		ContactEventType Type;
+		World::ID IdA;
+		World::ID IdB;
+	};
+
+	World::ID AddCircle(World& world, const Vec2& position)
+	{
+		Particle circle;
+		circle.SetCircleRadius(1);
+		circle.SetPosition(position);
+		circle.SetKinematic(true);
+		return world.AddParticle(std::move(circle)).GetID();
+	}
+
+}
+
+// A step where a contact begins, one persists and one ends, received by a listener for every filter.
+int main()
+{
+	World world;
+	Particle floor;
+	floor.SetRectangleSize({20, 2});
+	floor.SetPosition({0, -1});
+	floor.SetKinematic(false);
+	const World::ID floorId = world.AddParticle(std::move(floor)).GetID();
+
+	// Sunk deep enough in the floor to still touch it after a step.
+	const World::ID persisting = AddCircle(world, {0, Real{0.5}});
+	const World::ID ending = AddCircle(world, {5, Real{0.5}});
+	const World::ID beginning = AddCircle(world, {-100, 100});
+
+	struct Listened {
+		ContactEventFilter Filter;
+		std::vector<World::ContactEvent> Events;
+	};
+	std::vector<Listened> listeners;
+	for (uint32_t mask = 1; mask < 8; ++mask) listeners.push_back({{(mask & 1) != 0, (mask & 2) != 0, (mask & 4) != 0}, {}});
+	for (Listened& listened : listeners) {
+		world.AddContactListener([&listened](const std::span<const World::ContactEvent> events) {
+			listened.Events.insert(listened.Events.end(), events.begin(), events.end());
+		}, listened.Filter);
+	}
+
+	world.Step(Real{1} / 60);
+	world.find(ending)->SetPosition({-100, -100});
+	world.find(beginning)->SetPosition({-5, Real{0.5}});
+	for (Listened& listened : listeners) listened.Events.clear();
+	world.Step(Real{1} / 60);
+
+	// Delivered Persist, Begin then End.
+	const ExpectedEvent stepEvents[] {
+		{ContactEventType::Persist, floorId, persisting},
+		{ContactEventType::Begin, floorId, beginning},
+		{ContactEventType::End, floorId, ending},
+	};
+	for (const Listened& listened : listeners) {
+		std::vector<ExpectedEvent> expected;
+		for (const ExpectedEvent& event : stepEvents) {
+			const bool isListened = event.Type == ContactEventType::Begin ? listened.Filter.Begin : event.Type == ContactEventType::Persist ? listened.Filter.Persist : listened.Filter.End;
+			if (isListened) expected.push_back(event);
+		}
+
+		FYC_CHECK(listened.Events.size() == expected.size());
+		if (listened.Events.size() != expected.size()) continue;
+		for (uint64_t i = 0; i < expected.size(); ++i) {
+			FYC_CHECK(listened.Events[i].Type == expected[i].Type);
+			FYC_CHECK(listened.Events[i].IdA == expected[i].IdA);
+			FYC_CHECK(listened.Events[i].IdB == expected[i].IdB);
+		}
+	}
+
+	return Tests::s_Failures;
+}
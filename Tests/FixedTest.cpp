@@ -0,0 +1,49 @@
+#include "Physics/Fixed.hpp"
+#include "Check.hpp"
+
+using namespace FYC;
+
+namespace {
+
+	/// Deterministic raw values over the whole range, biased toward the small ones the simulation uses.
+	Fixed::RawType NextRaw(uint64_t& state)
+	{
+		state = state * 6364136223846793005ull + 1442695040888963407ull;
+		const uint64_t bits = state >> 1;
+		const int width = static_cast<int>(state >> 58);
+		const auto magnitude = static_cast<Fixed::RawType>(width >= 63 ? bits : bits & ((uint64_t(1) << width) - 1));
+		return (state & 1) ? -magnitude : magnitude;
+	}
+
+}
+
+int main()
+{
+	// Products past 2^31 and quotients of dividends past 2^47 raw used to overflow.
+	FYC_CHECK(Fixed(46341) * Fixed(46341) == Fixed(int64_t(46341) * 46341));
+	FYC_CHECK(Fixed(-46341) * Fixed(46341) == Fixed(-int64_t(46341) * 46341));
+	FYC_CHECK(Fixed(int64_t(1) << 40) / Fixed(1024) == Fixed(int64_t(1) << 30));
+	FYC_CHECK(Fixed(int64_t(1) << 40) / Fixed(-2) == Fixed(-(int64_t(1) << 39)));
+	FYC_CHECK(Fixed::FromRaw(Fixed::MaxRaw) / Fixed(2) == Fixed::FromRaw(Fixed::MaxRaw / 2));
+	FYC_CHECK(Fixed(3) / Fixed(2) == Fixed(1.5));
+	FYC_CHECK(Fixed(-3) / Fixed(4) == Fixed(-0.75));
+
+	// Out of the range, saturated.
+	FYC_CHECK(Fixed(int64_t(1) << 40) * Fixed(int64_t(1) << 40) == Fixed::FromRaw(Fixed::MaxRaw));
+	FYC_CHECK(Fixed(int64_t(1) << 40) * Fixed(-(int64_t(1) << 40)) == Fixed::FromRaw(Fixed::MinRaw));
+	FYC_CHECK(Fixed(int64_t(1) << 40) / Fixed(0.0001) == Fixed::FromRaw(Fixed::MaxRaw));
+	FYC_CHECK(Fixed(-(int64_t(1) << 40)) / Fixed(0.0001) == Fixed::FromRaw(Fixed::MinRaw));
+	FYC_CHECK(Fixed(1) / Fixed(0) == Fixed::FromRaw(Fixed::MaxRaw));
+
+	// The portable path gives the same bits as the operators, whichever one they use.
+	uint64_t state = 1;
+	for (int i = 0; i < 1000000; ++i) {
+		const Fixed::RawType a = NextRaw(state);
+		const Fixed::RawType b = NextRaw(state);
+		FYC_CHECK((Fixed::FromRaw(a) * Fixed::FromRaw(b)).Raw == Fixed::PortableMultiply(a, b));
+		if (b != 0) FYC_CHECK((Fixed::FromRaw(a) / Fixed::FromRaw(b)).Raw == Fixed::PortableDivide(a, b));
+		if (Tests::s_Failures > 10) break;
+	}
+
+	return Tests::s_Failures;
+}
@@ -0,0 +1,52 @@
+#include "Physics/FunctionRef.hpp"
+#include "Check.hpp"
+
+using namespace FYC;
+
+namespace {
+
+	int Twice(const int value)
+	{
+		return value * 2;
+	}
+
+	int Call(const FunctionRef<int(int)> function, const int value)
+	{
+		return function(value);
+	}
+
+}
+
+int main()
+{
+	// A free function, a capturing lambda and a copy of the reference all call the same callable.
+	FYC_CHECK(Call(Twice, 4) == 8);
+	int offset = 10;
+	const auto add = [&offset](const int value) { return value + offset; };
+	FYC_CHECK(Call(add, 1) == 11);
+	offset = 20;
+	FYC_CHECK(Call(add, 1) == 21);
+	const FunctionRef<int(int)> reference = add;
+	const FunctionRef<int(int)> copy = reference;
+	FYC_CHECK(copy(2) == 22);
+
+	// The callable is referenced, not copied: its state changes.
+	int calls = 0;
+	auto count = [&calls, total = 0](const int value) mutable { total += value; ++calls; return total; };
+	const FunctionRef<int(int)> counter = count;
+	FYC_CHECK(counter(3) == 3);
+	FYC_CHECK(counter(4) == 7);
+	FYC_CHECK(calls == 2);
+	FYC_CHECK(count(1) == 8);
+
+	// The arguments are forwarded, a move-only one included, and the result converted.
+	const auto take = [](std::unique_ptr<int> value) { return *value; };
+	FYC_CHECK(FunctionRef<long(std::unique_ptr<int>)>(take)(std::make_unique<int>(5)) == 5);
+	int target = 0;
+	const auto assign = [](int& value) { value = 7; };
+	const FunctionRef<void(int&)> assignReference = assign;
+	assignReference(target);
+	FYC_CHECK(target == 7);
+
+	return Tests::s_Failures;
+}
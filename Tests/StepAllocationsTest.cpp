@@ -0,0 +1,68 @@
+#include "Physics/World.hpp"
+#include "Check.hpp"
+
+using namespace FYC;
+
+namespace {
+
+	constexpr uint32_t StepCount = 150;
+
+	/// A pile on a floor, bouncing balls, a bullet and a sensor, so every part of the step runs.
+	void Populate(World& world)
+	{
+		world.Bounds = AABB::FromCenterSize({0, 0}, {60, 40});
+		world.AddParticle(Particle::CreateRectangle({0, 10}, {40, 1}))->SetKinematic(false);
+		auto sensor = world.AddParticle(Particle::CreateRectangle({15, 5}, {4, 4}));
+		sensor->SetKinematic(false);
+		sensor->SetSensor(true);
+
+		for (int row = 0; row < 8; ++row) {
+			for (int i = 0; i < 8 - row; ++i) {
+				world.AddParticle(Particle::CreateRectangle({Real(i) - Real(4) + Real(row) * Real(0.5), Real(9) - Real(row)}, {1, 1}, {0, 0}, {0, 10}));
+			}
+		}
+		for (int i = 0; i < 6; ++i) {
+			auto ball = world.AddParticle(Particle::CreateCircle({Real(10 + i * 2), Real(-5 - i)}, Real(0.5), {3, 0}, {0, 10}));
+			ball->SetRebound(Real(0.95));
+			ball->SetDrag(1);
+		}
+		auto bullet = world.AddParticle(Particle::CreateCircle({-20, 0}, Real(0.3), {40, 0}, {0, 10}));
+		bullet->SetBullet(true);
+		bullet->SetRebound(1);
+		bullet->SetDrag(1);
+	}
+
+}
+
+// Once a world went through a run, replaying it from a snapshot allocates nothing: every buffer is already big enough.
+int main()
+{
+	for (const SolverType type : {SolverType::Iterative, SolverType::Speculative, SolverType::SequentialImpulse, SolverType::Substepping}) {
+		for (const uint32_t substeps : {1u, 4u}) {
+			for (const uint32_t threads : {1u, 3u}) {
+				World world;
+				world.Solver.Type = type;
+				world.Solver.ThreadCount = threads;
+				Populate(world);
+				uint64_t events = 0;
+				world.AddContactListener([&events](const std::span<const World::ContactEvent> contacts) { events += contacts.size(); });
+				world.AddSensorListener([&events](const std::span<const World::SensorEvent> overlaps) { events += overlaps.size(); });
+
+				const World::Snapshot snapshot = world.TakeSnapshot();
+				for (uint32_t i = 0; i < StepCount; ++i) world.Step(Real{1} / 60, substeps);
+				world.Restore(snapshot);
+
+				uint64_t allocations = 0;
+				for (uint32_t i = 0; i < StepCount; ++i) {
+					world.Step(Real{1} / 60, substeps);
+					allocations += world.GetStepStatistics().HeapAllocations;
+				}
+				FYC_CHECK(events > 0);
+				FYC_CHECK(allocations == 0);
+				if (allocations != 0) std::fprintf(stderr, "solver %d, %u substeps, %u threads: %llu allocations\n", static_cast<int>(type), substeps, threads, static_cast<unsigned long long>(allocations));
+			}
+		}
+	}
+
+	return Tests::s_Failures;
+}
@@ -0,0 +1,57 @@
+#include "Physics/World.hpp"
+#include "Physics/MemoryResource.hpp"
+#include "Check.hpp"
+
+using namespace FYC;
+
+namespace {
+
+	void Populate(World& world, const int count)
+	{
+		world.AddParticle(Particle::CreateRectangle({0, 10}, {40, 1}))->SetKinematic(false);
+		for (int i = 0; i < count; ++i) world.AddParticle(Particle::CreateCircle({Real(i) - Real(count / 2), Real(8)}, Real(0.6), {0, 0}, {0, 10}));
+		world.AddContactListener([](std::span<const World::ContactEvent>) {});
+		for (int i = 0; i < 30; ++i) world.Step(Real{1} / 60);
+	}
+
+}
+
+// Moving a world into one using another resource keeps every container in the resource of the one assigned to.
+int main()
+{
+	CountingResource resourceA;
+	CountingResource resourceB;
+	{
+		World a(&resourceA);
+		World b(&resourceB);
+		Populate(a, 10);
+		Populate(b, 20);
+
+		a = std::move(b);
+		FYC_CHECK(a.GetMemoryResource() == &resourceA);
+		FYC_CHECK(a.count() == 21);
+		for (int i = 0; i < 30; ++i) a.Step(Real{1} / 60);
+		FYC_CHECK(a.count() == 21);
+
+		// The world moved from stays usable.
+		Populate(b, 5);
+		FYC_CHECK(b.GetMemoryResource() == &resourceB);
+	}
+	// Everything was given back to the resource it came from.
+	FYC_CHECK(resourceA.GetUsage().Bytes == 0);
+	FYC_CHECK(resourceB.GetUsage().Bytes == 0);
+
+	// Same resource, the worlds are exchanged.
+	{
+		World a(&resourceA);
+		World b(&resourceA);
+		Populate(a, 10);
+		Populate(b, 20);
+		a = std::move(b);
+		FYC_CHECK(a.count() == 21);
+		a.Step(Real{1} / 60);
+	}
+	FYC_CHECK(resourceA.GetUsage().Bytes == 0);
+
+	return Tests::s_Failures;
+}
@@ -0,0 +1,60 @@
+#include "Physics/WorldScheduler.hpp"
+#include "Check.hpp"
+
+using namespace FYC;
+
+namespace {
+
+	void Fill(World& world, const uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; ++i) {
+			Particle circle;
+			circle.SetCircleRadius(1);
+			circle.SetPosition({static_cast<Real>(i % 8) * 3, static_cast<Real>(i / 8) * 3});
+			circle.SetKinematic(true);
+			world.AddParticle(std::move(circle));
+		}
+	}
+
+}
+
+// Steps back to back, each StepAsync replacing the promise the workers just fulfilled, gives the serial result.
+int main()
+{
+	constexpr uint32_t worldCount = 6;
+	constexpr uint32_t stepCount = 2000;
+	const Real stepTime = Real{1} / 60;
+
+	std::vector<World> scheduled(worldCount);
+	std::vector<World> serial(worldCount);
+	for (uint32_t i = 0; i < worldCount; ++i) {
+		Fill(scheduled[i], 4 + i * 4);
+		Fill(serial[i], 4 + i * 4);
+	}
+
+	{
+		WorldScheduler scheduler(4);
+		for (World& world : scheduled) scheduler.AddWorld(world);
+		for (uint32_t step = 0; step < stepCount; ++step) (void)scheduler.StepAsync(stepTime);
+		scheduler.Wait();
+	}
+	for (World& world : serial) {
+		for (uint32_t step = 0; step < stepCount; ++step) world.Step(stepTime, 1);
+	}
+
+	for (uint32_t i = 0; i < worldCount; ++i) {
+		FYC_CHECK(scheduled[i].count() == serial[i].count());
+		for (auto it = serial[i].begin(); it != serial[i].end(); ++it) {
+			const auto found = scheduled[i].find(it.GetID());
+			FYC_CHECK(found != scheduled[i].end());
+			if (found == scheduled[i].end()) continue;
+			FYC_CHECK(found->GetPosition().x == it->GetPosition().x && found->GetPosition().y == it->GetPosition().y);
+		}
+	}
+
+	// Without any world the future is ready at once, every time.
+	WorldScheduler empty(2);
+	for (uint32_t step = 0; step < stepCount; ++step) empty.StepAsync(stepTime).get();
+
+	return Tests::s_Failures;
+}
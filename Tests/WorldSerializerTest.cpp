@@ -0,0 +1,190 @@
+#include "WorldSerializer.hpp"
+#include "Check.hpp"
+
+using namespace FYC;
+using namespace FYC::Application;
+
+namespace {
+
+	bool IsEqual(const Vec2& a, const Vec2& b, const Real tolerance = Real{0})
+	{
+		return Math::Abs(a.x - b.x) <= tolerance && Math::Abs(a.y - b.y) <= tolerance;
+	}
+
+	/// The tolerance is on the position and the size of the shape, a rectangle is stored by its corners and its center may be rounded.
+	bool IsEqual(const Particle& a, const Particle& b, const Real tolerance)
+	{
+		Circle circleA, circleB;
+		AABB rectangleA, rectangleB;
+		const bool sameShape = (a.HasShape<Circle>(circleA) && b.HasShape<Circle>(circleB) && circleA.Radius == circleB.Radius)
+			|| (a.HasShape<AABB>(rectangleA) && b.HasShape<AABB>(rectangleB) && IsEqual(rectangleA.GetSize(), rectangleB.GetSize(), tolerance));
+		const Color colorA = std::any_cast<Color>(a.Data);
+		const Color colorB = std::any_cast<Color>(b.Data);
+		return sameShape && IsEqual(a.GetPosition(), b.GetPosition(), tolerance) && IsEqual(a.GetVelocity(), b.GetVelocity())
+			&& IsEqual(a.GetConstantAccelerations(), b.GetConstantAccelerations()) && a.GetRebound() == b.GetRebound() && a.GetDrag() == b.GetDrag()
+			&& a.IsKinematic() == b.IsKinematic() && a.IsAwake() == b.IsAwake() && a.IsBullet() == b.IsBullet() && a.IsSensor() == b.IsSensor()
+			&& colorA.r == colorB.r && colorA.g == colorB.g && colorA.b == colorB.b && colorA.a == colorB.a;
+	}
+
+	bool IsEqual(World& a, World& b, const Real tolerance = Real{0})
+	{
+		if (a.count() != b.count()) return false;
+		for (auto it = a.begin(); it != a.end(); ++it) {
+			const auto other = b.find(it.GetID());
+			if (other == b.end() || !IsEqual(*it, *other, tolerance)) return false;
+		}
+		return true;
+	}
+
+	World CreateWorld()
+	{
+		World world;
+		world.Bounds = AABB::FromMinMax({-50, -20}, {50, 40});
+		for (int32_t i = 0; i < 40; ++i) {
+			const Vec2 position{static_cast<Real>(i * 3 - 60), static_cast<Real>(i % 7) * Real{2.5}};
+			Particle particle = i % 2 == 0 ? Particle::CreateCircle(position, Real{0.5} + static_cast<Real>(i % 3)) : Particle::CreateRectangle(position, {2, Real{1.5}});
+			particle.SetVelocity({static_cast<Real>(i), -1});
+			particle.AddConstantAcceleration({0, Real{-9.8}});
+			particle.SetRebound(Real{0.25});
+			particle.SetDrag(Real{0.75});
+			particle.SetKinematic(i % 5 != 0);
+			particle.SetBullet(i % 7 == 0);
+			particle.SetSensor(i % 11 == 0);
+			particle.Data = Color{static_cast<unsigned char>(i), 20, 30, 255};
+			world.AddParticle(std::move(particle));
+		}
+		return world;
+	}
+
+	/// Offset of the first particle record of a valid level.
+	uint64_t GetParticlesOffset(const std::vector<char>& binary)
+	{
+		LevelView level;
+		if (!WorldSerializer::ReadLevel(binary, level)) return 0;
+		return static_cast<uint64_t>(level.Particles - binary.data());
+	}
+
+	/// Offset of the tile size of a valid chunked level, found from its section table.
+	uint64_t GetTilingOffset(const std::vector<char>& binary)
+	{
+		using namespace LevelFormat;
+		const uint16_t sectionCount = static_cast<uint8_t>(binary[6]) | static_cast<uint16_t>(static_cast<uint8_t>(binary[7]) << 8);
+		for (uint16_t i = 0; i < sectionCount; ++i) {
+			const char* entry = binary.data() + HeaderSize + i * SectionEntrySize;
+			uint32_t type;
+			uint64_t offset;
+			std::memcpy(&type, entry, sizeof(type));
+			std::memcpy(&offset, entry + 16, sizeof(offset));
+			if (static_cast<Section>(type) == Section::Tiling) return offset;
+		}
+		return 0;
+	}
+
+	void WriteDouble(std::vector<char>& binary, const uint64_t offset, const double value)
+	{
+		std::memcpy(binary.data() + offset, &value, sizeof(value));
+	}
+
+	/// A corrupt file is rejected and leaves the world as it was.
+	bool IsRejected(const std::vector<char>& binary)
+	{
+		World world;
+		world.AddParticle(Particle::CreateCircle({0, 0}, 1));
+		return !WorldSerializer::FromBinary(binary, world) && world.count() == 1;
+	}
+
+}
+
+int main()
+{
+	World source = CreateWorld();
+
+	// Round trip, plain and chunked.
+	{
+		const std::vector<char> binary = WorldSerializer::ToBinary(source);
+		World decoded;
+		FYC_CHECK(WorldSerializer::FromBinary(binary, decoded));
+		FYC_CHECK(IsEqual(source, decoded));
+		FYC_CHECK(std::holds_alternative<AABB>(decoded.Bounds) && IsEqual(std::get<AABB>(decoded.Bounds).Min, {-50, -20}));
+
+		const std::vector<char> chunked = WorldSerializer::ToChunkedBinary(source, 16);
+		LevelView level;
+		FYC_CHECK(WorldSerializer::ReadLevel(chunked, level) && level.TileCount > 1 && level.TileSize == 16);
+		World decodedChunked;
+		FYC_CHECK(WorldSerializer::FromBinary(chunked, decodedChunked));
+		FYC_CHECK(IsEqual(source, decodedChunked));
+		FYC_CHECK(WorldSerializer::ToBinary(decodedChunked) == binary);
+	}
+
+	// Corrupt files.
+	{
+		const std::vector<char> binary = WorldSerializer::ToBinary(source);
+		for (uint64_t size = LevelFormat::HeaderSize; size < binary.size(); size += 7) {
+			FYC_CHECK(IsRejected(std::vector<char>(binary.begin(), binary.begin() + static_cast<std::ptrdiff_t>(size))));
+		}
+
+		std::vector<char> unknownShape = binary;
+		unknownShape[GetParticlesOffset(binary) + 5 * LevelFormat::ParticleField::RecordSize + LevelFormat::ParticleField::ShapeType] = 2;
+		FYC_CHECK(IsRejected(unknownShape));
+
+		std::vector<char> newerVersion = binary;
+		newerVersion[4] = static_cast<char>(LevelFormat::Version + 1);
+		FYC_CHECK(IsRejected(newerVersion));
+
+		const std::vector<char> chunked = WorldSerializer::ToChunkedBinary(source, 16);
+		const uint64_t tilingOffset = GetTilingOffset(chunked);
+		FYC_CHECK(tilingOffset != 0);
+		for (const double tileSize : {0.0, -16.0, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity()}) {
+			std::vector<char> badTiling = chunked;
+			WriteDouble(badTiling, tilingOffset, tileSize);
+			FYC_CHECK(IsRejected(badTiling));
+		}
+	}
+
+	// A delta brings a copy of the baseline to the state of the stepped and edited world.
+	{
+		World sender = CreateWorld();
+		World receiver;
+		FYC_CHECK(WorldSerializer::FromBinary(WorldSerializer::ToBinary(sender), receiver));
+		sender.ClearChanges();
+
+		for (int32_t step = 0; step < 10; ++step) {
+			sender.Step(Real{1} / 60);
+			if (step == 3) sender.RemoveParticle(sender.begin().GetID());
+			if (step == 5) {
+				Particle created = Particle::CreateRectangle({5, 5}, {1, 3});
+				created.Data = Color{1, 2, 3, 4};
+				sender.AddParticle(std::move(created));
+			}
+			if (step == 7) {
+				auto it = sender.begin();
+				++it;
+				it->SetRebound(Real{0.5});
+				it->SetVelocity({3, 4});
+			}
+			const std::vector<char> delta = WorldSerializer::ToDelta(sender);
+			sender.ClearChanges();
+			FYC_CHECK(WorldSerializer::ApplyDelta(delta, receiver));
+			FYC_CHECK(IsEqual(sender, receiver, Real{0.0001}));
+		}
+	}
+
+	// The files written before the format was versioned are raw structs of a float build.
+#if !defined(FYC_DOUBLE) && !defined(FYC_FIXED)
+	{
+		std::ifstream file(FYC_LEVELS_DIRECTORY "/world.fyc", std::ios::binary);
+		const std::vector<char> legacy{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+		World decoded;
+		FYC_CHECK(WorldSerializer::FromBinary(legacy, decoded));
+		FYC_CHECK(decoded.count() == 12);
+
+		World reloaded;
+		FYC_CHECK(WorldSerializer::FromBinary(WorldSerializer::ToBinary(decoded), reloaded));
+		FYC_CHECK(IsEqual(decoded, reloaded));
+
+		FYC_CHECK(IsRejected(std::vector<char>(legacy.begin(), legacy.end() - 1)));
+	}
+#endif
+
+	return Tests::s_Failures;
+}